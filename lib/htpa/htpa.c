@@ -5,33 +5,98 @@
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
 
 uint8_t data_top[4][258];
 uint8_t data_bottom[4][258];
 uint8_t electrical_offset_top[258];
 uint8_t electrical_offset_bottom[258];
-
-extern SemaphoreHandle_t htpa_mutex;
-
+static bool blind_started = false;
+static uint16_t pixel_map[2][HTPA_BLOCKS][HTPA_PIXELS_PER_BLOCK];
+static uint16_t eloffset_map[2][HTPA_PIXELS_PER_BLOCK];
+
+// Per-frame compensation plan of the fixed point engine
+static struct {
+    bool valid;
+    uint16_t PTATav;
+    uint16_t VDDav;
+    int32_t offset[HTPA_ROWS][HTPA_COLS];
+    uint16_t column[HTPA_MAX_AD_ELEMENTS];
+} plan;
+static const HTPA_Table_t *table = NULL;
+static uint32_t dead_mask[HTPA_ROWS];     // defective pixels, replaced by HTPA_PixelMasking
+// filter_request is posted by HTPA_SetFilter from any task, the sensor task
+// takes it over at the start of a frame and alone owns the filter state
+static volatile bool filter_request = HTPA_FILTER_DEFAULT;
+static bool filter_enabled = HTPA_FILTER_DEFAULT;
+static bool filter_valid = false;
+static int32_t filter_state[HTPA_ROWS][HTPA_COLS];
+
+// Raw frame sums of the current oversampling window
+static volatile uint8_t oversample = HTPA_OVERSAMPLE_DEFAULT;
+static struct {
+    uint8_t frames;                 // window size, latched when the window starts
+    uint8_t count;
+    uint32_t PTATav;
+    uint32_t VDDav;
+    uint32_t pixelData[HTPA_ROWS][HTPA_COLS];
+    uint32_t electricalOffsets[HTPA_BLOCKS * 2][HTPA_COLS];
+} accum;
+static volatile bool pipelined = HTPA_PIPELINED_DEFAULT;
+static uint32_t conv_start_us = 0;
+static uint32_t conv_time_us = 0;
+static uint16_t conv_trim = 0;
+static HTPA_Timing_t capture_timing;     // filled during a capture, published with the frame
+
+// Triple buffered frame exchange: the producer owns one slot, the consumer
+// another, and the third is swapped atomically together with a fresh flag
+#define FRAME_FRESH 0x04
+static HTPA_Frame_t frames[3];
+static uint8_t frame_write = 0;
+static uint8_t frame_read = 2;
+static atomic_uint frame_exchange = 1;
+static uint32_t frame_number = 0;
+
+static void HTPA_BuildDeadMask(HTPA_EEPROM_Data_t *eeprom);
 
 int HTPA_Init(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom, int i2c_num, int sda_pin, int scl_pin) {
-    
+    // capture starts from a clean working state
+    memset(data, 0, sizeof(*data));
+
     CHECK_ERROR(HTPA_I2C_Init(i2c_num, sda_pin, scl_pin, 1000000));
     CHECK_ERROR(HTPA_ReadEEPROM(eeprom));
     // HTPA_PrintEEPROM(eeprom);
+    table = HTPA_FindTable(eeprom->TN, HTPA_TABLE_VARIANT);
+    if (!table) {
+        printf("\n\nHINT:\tNo look up table for connected sensor with tablenumber %u.", eeprom->TN);
+        printf("\n\tAdd it to lookuptable.h.");
+        return HTPA_ERR;
+    }
+    plan.valid = false;
+    HTPA_BuildSortMap();
+    HTPA_BuildDeadMask(eeprom);
     uint8_t config = CONFIG_WAKEUP;
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_CONFIG_REG, &config, 1));
+    HTPA_I2C_Xfer_t wakeup = { HTPA_CONFIG_REG, false, &config, 1, HTPA_TRIM_SETTLE_US };
+    CHECK_ERROR(HTPA_I2C_Transfer(&wakeup, 1));
     CHECK_ERROR(HTPA_LoadCalibration(eeprom, false));
 
-    HTPA_CalculatePixelSensitivity(data, eeprom);
+    HTPA_CalculateSensitivity(eeprom);
+    return HTPA_OK;
+}
 
-    if (eeprom->TN != TABLENUMBER) {
-        printf("\n\nHINT:\tConnected sensor does not match the selected look up table.");
-        printf("\n\tThe calculated temperatures could be wrong!");
-        printf("\n\tChange device in sensordef_32x32.h to sensor with tablenumber ");
-        printf("%u", eeprom->TN);
+const HTPA_Table_t *HTPA_FindTable(uint16_t TN, uint8_t variant) {
+    const HTPA_Table_t *fallback = NULL;
+    for (size_t i = 0; i < sizeof(HTPA_Tables) / sizeof(HTPA_Tables[0]); i++) {
+        if (HTPA_Tables[i].TN != TN) continue;
+        if (HTPA_Tables[i].variant == variant) return &HTPA_Tables[i];
+        if (HTPA_Tables[i].variant == HTPA_TABLE_STANDARD) fallback = &HTPA_Tables[i];
     }
-    return HTPA_OK;
+    return fallback;
+}
+
+const HTPA_Table_t *HTPA_GetTable(void) {
+    return table;
 }
 
 int HTPA_LoadCalibration(HTPA_EEPROM_Data_t *eeprom, bool user_calibration) {
@@ -41,19 +106,28 @@ int HTPA_LoadCalibration(HTPA_EEPROM_Data_t *eeprom, bool user_calibration) {
     uint8_t CLK = user_calibration ? eeprom->CLK_user : eeprom->CLK_calib;
     uint8_t BPA = user_calibration ? eeprom->BPA_user : eeprom->BPA_calib;
     uint8_t PU = user_calibration ? eeprom->PU_user : eeprom->PU_calib;
+
+    // conversion time depends on CLK and MBIT, relearn it when they change
+    if (conv_trim != ((CLK << 8) | MBIT)) {
+        conv_trim = (CLK << 8) | MBIT;
+        conv_time_us = 0;
+    }
     
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG1, &MBIT, 1));
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG2, &BIAS, 1));
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG3, &BIAS, 1));
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG4, &CLK, 1));
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG5, &BPA, 1));
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG6, &BPA, 1));
-    CHECK_ERROR(HTPA_I2C_Write(HTPA_TRIM_REG7, &PU, 1));
+    HTPA_I2C_Xfer_t xfer[] = {
+        { HTPA_TRIM_REG1, false, &MBIT, 1, 0 },
+        { HTPA_TRIM_REG2, false, &BIAS, 1, 0 },
+        { HTPA_TRIM_REG3, false, &BIAS, 1, 0 },
+        { HTPA_TRIM_REG4, false, &CLK,  1, 0 },
+        { HTPA_TRIM_REG5, false, &BPA,  1, 0 },
+        { HTPA_TRIM_REG6, false, &BPA,  1, 0 },
+        { HTPA_TRIM_REG7, false, &PU,   1, HTPA_TRIM_SETTLE_US },
+    };
+    CHECK_ERROR(HTPA_I2C_Transfer(xfer, sizeof(xfer) / sizeof(xfer[0])));
 
     return HTPA_OK;
 }
 
-void HTPA_CalculatePixelSensitivity(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
+void HTPA_CalculateSensitivity(HTPA_EEPROM_Data_t *eeprom) {
     for (int i = 0; i < HTPA_ROWS; i++) {
         for (int j = 0; j < HTPA_COLS; j++) {
             // calc sensitivity coefficients (see datasheet, chapter: 11.5 Object Temperature)
@@ -62,60 +136,181 @@ void HTPA_CalculatePixelSensitivity(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eepro
             pixc_steps = pixc_steps * eeprom->P[i][j];
             pixc_steps = pixc_steps + eeprom->PixCmin;
             pixc_steps = pixc_steps * 1.0 * eeprom->epsilon / 100;
-            data->pix_c[i][j] = pixc_steps * 1.0 * eeprom->GlobalGain / 10000;
+            eeprom->pix_c[i][j] = pixc_steps * 1.0 * eeprom->GlobalGain / 10000;
+
+            // reciprocal sensitivity for the fixed point engine
+            double recip = (double)table->PCScaleVal / eeprom->pix_c[i][j] * (1 << HTPA_RECIP_SHIFT);
+            eeprom->pix_c_recip[i][j] = (recip > 0 && recip < UINT32_MAX) ? (uint32_t)(recip + 0.5) : 0;
         }
     }
 }
 
+static void HTPA_BuildDeadMask(HTPA_EEPROM_Data_t *eeprom) {
+    memset(dead_mask, 0, sizeof(dead_mask));
+    for (int i = 0; i < eeprom->NrOfDefPix; i++) {
+        dead_mask[eeprom->DeadPixAdr[i] >> 5] |= 1UL << (eeprom->DeadPixAdr[i] % 32);
+    }
+}
+
+static int HTPA_StartConversion(uint8_t config) {
+    if (HTPA_I2C_Write(HTPA_CONFIG_REG, &config, 1)) {
+        return HTPA_ERR;
+    }
+    conv_start_us = micros();
+    return HTPA_OK;
+}
+
 uint8_t HTPA_WaitDataReady(uint32_t timeout_ms) {
-   uint8_t status = 0;
-   uint32_t start = millis();
-
-   do {
-       if (HTPA_I2C_Read(HTPA_STATUS_REG, &status, 1)) {
-           break;
-       }
-       
-       if (status & STATUS_EOC) {
-           break;
-       }
-
-       if (millis() - start > timeout_ms) {
-           break;
-       }
-       delay(1);
-   } while (1);
-   return status;
+    uint8_t status = 0;
+    uint32_t start = micros();
+
+    // sleep through the predicted conversion time, poll only around the expected EOC
+    uint32_t elapsed = start - conv_start_us;
+    if (conv_time_us > elapsed + HTPA_EOC_GUARD_US) {
+        uint32_t sleep_us = conv_time_us - elapsed - HTPA_EOC_GUARD_US;
+        // whole ticks yield the core, the sub-tick rest is a short busy wait
+        delay(sleep_us / 1000);
+        delayMicroseconds(sleep_us % 1000);
+        capture_timing.sleep_us += micros() - start;
+    }
+
+    do {
+        if (HTPA_I2C_Read(HTPA_STATUS_REG, &status, 1)) {
+            break;
+        }
+        capture_timing.status_polls++;
+
+        if (status & STATUS_EOC) {
+            // learn the conversion time of the current trim settings
+            uint32_t measured = micros() - conv_start_us;
+            conv_time_us = conv_time_us ? (conv_time_us * 3 + measured) / 4 : measured;
+            break;
+        }
+
+        if (micros() - start > timeout_ms * 1000) {
+            break;
+        }
+        delayMicroseconds(HTPA_EOC_POLL_US);
+    } while (1);
+
+    capture_timing.wait_us += micros() - start;
+    return status;
+}
+
+void HTPA_BuildSortMap(void) {
+    for (int block = 0; block < HTPA_BLOCKS; block++) {
+        for (int k = 0; k < HTPA_PIXELS_PER_BLOCK; k++) {
+            uint8_t i = k / HTPA_COLS;
+            uint8_t j = k % HTPA_COLS;
+            // top half is read row by row, bottom half blocks and rows are mirrored
+            pixel_map[0][block][k] = (block * 4 + i) * HTPA_COLS + j;
+            pixel_map[1][block][k] = (16 + (3 - block) * 4 + (3 - i)) * HTPA_COLS + j;
+        }
+    }
+    for (int k = 0; k < HTPA_PIXELS_PER_BLOCK; k++) {
+        eloffset_map[0][k] = k;
+        eloffset_map[1][k] = (4 + 3 - k / HTPA_COLS) * HTPA_COLS + k % HTPA_COLS;
+    }
+}
+
+// Big endian block readout to host order, skipping the PTAT/VDD word
+static void HTPA_Unscramble(uint16_t *dst, const uint8_t *src, const uint16_t *map) {
+    src += 2;
+    for (int k = 0; k < HTPA_PIXELS_PER_BLOCK; k++) {
+        dst[map[k]] = (src[2 * k] << 8) | src[2 * k + 1];
+    }
+}
+
+static void HTPA_SortElOffsets(HTPA_Data_t *data) {
+    plan.valid = false;
+    HTPA_Unscramble(&data->electricalOffsets[0][0], electrical_offset_top, eloffset_map[0]);
+    HTPA_Unscramble(&data->electricalOffsets[0][0], electrical_offset_bottom, eloffset_map[1]);
+}
+
+static void HTPA_CalculateAverages(HTPA_Data_t *data) {
+    uint32_t ptat_sum = 0;
+    uint32_t vdd_sum = 0;
+    for (int i = 0; i < 8; i++) {
+        vdd_sum += data->VDD[i];
+        ptat_sum += data->PTAT[i];
+    }
+    data->VDDav = (uint16_t)(vdd_sum / 8);
+    data->PTATav = (uint16_t)(ptat_sum / 8);
 }
 
 int HTPA_GetElOffsets() {
-    uint8_t config = CONFIG_WAKEUP | CONFIG_START | CONFIG_BLIND;
-    if (HTPA_I2C_Write(HTPA_CONFIG_REG, &config, 1)) {
+    // blind conversion may already be running, started by the last pixel block
+    if (!blind_started) {
+        uint8_t config = CONFIG_WAKEUP | CONFIG_START | CONFIG_BLIND;
+        if (HTPA_StartConversion(config)) {
+            return HTPA_ERR;
+        }
+    }
+    blind_started = false;
+    // no end of conversion, the read registers still hold the last block
+    if (!(HTPA_WaitDataReady(1000) & STATUS_EOC)) {
         return HTPA_ERR;
     }
-    uint8_t status = HTPA_WaitDataReady(1000);
-    if (HTPA_I2C_Read(HTPA_READ_TOP, electrical_offset_top, 258) ||
-        HTPA_I2C_Read(HTPA_READ_BOTTOM, electrical_offset_bottom, 258)) {
+    HTPA_I2C_Xfer_t xfer[] = {
+        { HTPA_READ_TOP, true, electrical_offset_top, 258, 0 },
+        { HTPA_READ_BOTTOM, true, electrical_offset_bottom, 258, 0 },
+    };
+    uint32_t start = micros();
+    if (HTPA_I2C_Transfer(xfer, sizeof(xfer) / sizeof(xfer[0]))) {
         return HTPA_ERR;
     }
+    capture_timing.transfer_us += micros() - start;
     return HTPA_OK;
 }
 
-int HTPA_GetPixels(HTPA_Data_t *data, bool vdd_meas) {
+static uint8_t HTPA_BlockConfig(uint8_t block, bool vdd_meas) {
     uint8_t config = CONFIG_WAKEUP | CONFIG_START;
     if (vdd_meas) config |= CONFIG_VDD_MEAS;
+    return config | ((block & 0x03) << 4);
+}
+
+static int HTPA_ReadBlocks(HTPA_Data_t *data, bool vdd_meas, bool chain_blind) {
+    bool pipeline = pipelined;
+    uint8_t config = HTPA_BlockConfig(0, vdd_meas);
+    blind_started = false;
+    if (HTPA_StartConversion(config)) {
+        return HTPA_ERR;
+    }
 
     for (int block = 0; block < HTPA_BLOCKS; block++) {
-        config = (config & ~(0x03 << 4)) | ((block & 0x03) << 4);
-        if (HTPA_I2C_Write(HTPA_CONFIG_REG, &config, 1)) {
-            return HTPA_ERR;
+        HTPA_I2C_Xfer_t xfer[3];
+        uint8_t n = 0;
+        bool start_next = (block + 1 < HTPA_BLOCKS) || chain_blind;
+        if (block + 1 < HTPA_BLOCKS) {
+            config = HTPA_BlockConfig(block + 1, vdd_meas);
+        } else {
+            config = CONFIG_WAKEUP | CONFIG_START | CONFIG_BLIND;
         }
+
         // wait for end of conversion bit
-        uint8_t status = HTPA_WaitDataReady(1000);
-        if (HTPA_I2C_Read(HTPA_READ_TOP, data_top[block], 258) ||
-            HTPA_I2C_Read(HTPA_READ_BOTTOM, data_bottom[block], 258)) {
+        if (!(HTPA_WaitDataReady(1000) & STATUS_EOC)) {
             return HTPA_ERR;
         }
+        // result is latched, start the next conversion before draining the bus
+        if (pipeline && start_next) xfer[n++] = (HTPA_I2C_Xfer_t){ HTPA_CONFIG_REG, false, &config, 1, 0 };
+        xfer[n++] = (HTPA_I2C_Xfer_t){ HTPA_READ_TOP, true, data_top[block], 258, 0 };
+        xfer[n++] = (HTPA_I2C_Xfer_t){ HTPA_READ_BOTTOM, true, data_bottom[block], 258, 0 };
+        if (!pipeline && start_next) xfer[n++] = (HTPA_I2C_Xfer_t){ HTPA_CONFIG_REG, false, &config, 1, 0 };
+
+        uint32_t start = micros();
+        if (HTPA_I2C_Transfer(xfer, n)) {
+            return HTPA_ERR;
+        }
+        capture_timing.transfer_us += micros() - start;
+        if (start_next) {
+            conv_start_us = pipeline ? start : micros();
+            blind_started = (block + 1 == HTPA_BLOCKS);
+        }
+
+        // sort this block while the sensor converts the next one
+        HTPA_Unscramble(&data->pixelData[0][0], data_top[block], pixel_map[0][block]);
+        HTPA_Unscramble(&data->pixelData[0][0], data_bottom[block], pixel_map[1][block]);
+
         if(vdd_meas) {
             data->VDD[block] = (uint16_t)((data_top[block][0] << 8) | data_top[block][1]);
             data->VDD[block + 4] = (uint16_t)((data_bottom[block][0] << 8) | data_bottom[block][1]);
@@ -127,57 +322,188 @@ int HTPA_GetPixels(HTPA_Data_t *data, bool vdd_meas) {
     return HTPA_OK;
 }
 
+int HTPA_GetPixels(HTPA_Data_t *data, bool vdd_meas) {
+    return HTPA_ReadBlocks(data, vdd_meas, false);
+}
+
 void HTPA_SortData(HTPA_Data_t *data) {
+    for (int block = 0; block < HTPA_BLOCKS; block++) {
+        HTPA_Unscramble(&data->pixelData[0][0], data_top[block], pixel_map[0][block]);
+        HTPA_Unscramble(&data->pixelData[0][0], data_bottom[block], pixel_map[1][block]);
+    }
+    HTPA_SortElOffsets(data);
 
-    // Read pixel data
-    for (int block = 0; block < 4; block++) {
-        for (int j = 0; j < 32; j++) {
-            for (int i = 0; i < 4; i++) {
-                data->pixelData[block * 4 + i][j] = (data_top[block][2 * (j + i * 32) + 2] << 8) | data_top[block][2 * (j + i * 32) + 3];
-                data->pixelData[16 + block * 4 + i][j] = (data_bottom[3 - block][2 * j + (3 - i) * 64 + 2] << 8) | data_bottom[3 - block][2 * j + (3 - i) * 64 + 3];
-            }
+    // Calculate averages after all blocks are read
+    HTPA_CalculateAverages(data);
+}
+
+// Frame statistics are gathered in the calculation pass, defective pixels
+// are added once HTPA_PixelMasking replaced them
+static void HTPA_StatsReset(HTPA_Stats_t *stats) {
+    stats->minTemp = INT16_MAX;
+    stats->maxTemp = INT16_MIN;
+    stats->sum = 0;
+    memset(stats->hist, 0, sizeof(stats->hist));
+}
+
+static inline void HTPA_StatsAdd(HTPA_Stats_t *stats, int16_t temp, uint8_t row, uint8_t col) {
+    if (temp < stats->minTemp) {
+        stats->minTemp = temp;
+        stats->minRow = row;
+        stats->minCol = col;
+    }
+    if (temp > stats->maxTemp) {
+        stats->maxTemp = temp;
+        stats->maxRow = row;
+        stats->maxCol = col;
+    }
+    stats->sum += temp;
+
+    int32_t bin = (temp - HTPA_HIST_BASE) >> HTPA_HIST_SHIFT;
+    if (bin < 0) bin = 0;
+    if (bin > HTPA_HIST_BINS - 1) bin = HTPA_HIST_BINS - 1;
+    stats->hist[bin]++;
+}
+
+// Statistics of the temperatures left from the last calculation
+static void HTPA_StatsScan(HTPA_Data_t *data) {
+    HTPA_StatsReset(&data->stats);
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            if (!((dead_mask[i] >> j) & 1)) HTPA_StatsAdd(&data->stats, data->pixelTemps[i][j], i, j);
         }
     }
+}
 
-    // Read electrical offsets
-    for (int j = 0; j < 32; j++) {
-        for (int i = 0; i < 4; i++) {
-            data->electricalOffsets[i][j] = (electrical_offset_top[2 * (j + i * 32) + 2] << 8) | electrical_offset_top[2 * (j + i * 32) + 3];
-            data->electricalOffsets[4 + i][j] = (electrical_offset_bottom[2 * (j + (3 - i) * 32) + 2] << 8) | electrical_offset_bottom[2 * (j + (3 - i) * 32) + 3];
+static void HTPA_StatsFinish(HTPA_Stats_t *stats, const int16_t temps[HTPA_ROWS][HTPA_COLS]) {
+    const uint8_t r = HTPA_ROWS / 2, c = HTPA_COLS / 2;
+    stats->meanTemp = (stats->sum + HTPA_PIXELS / 2) / HTPA_PIXELS;
+    stats->centerTemp = (temps[r - 1][c - 1] + temps[r - 1][c] + temps[r][c - 1] + temps[r][c] + 2) >> 2;
+}
+
+#if (HTPA_CALC_ENGINE == HTPA_CALC_FIXED)
+// Same steps as the double engine below, in Q8 fixed point (1/256 of an ADC count).
+// Everything that depends only on PTATav, VDDav and the electrical offsets is
+// folded into a compensation plan, rebuilt only when one of them changes.
+static void HTPA_BuildPlan(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
+    uint16_t table_col = 0;
+    int32_t dta;
+    double ambientTemp = data->PTATav * eeprom->PTAT_gradient + eeprom->PTAT_offset;
+
+    // find column of lookup table
+    for (int i = 0; i < table->NrOfTaElements; i++) {
+        if (ambientTemp > table->XTATemps[i]) {
+            table_col = i;
         }
     }
+    dta = ambientTemp - table->XTATemps[table_col];
 
-    // Calculate averages after all blocks are read
-    uint32_t ptat_sum = 0;
-    uint32_t vdd_sum = 0;
-    for (int i = 0; i < 8; i++) {
-        vdd_sum += data->VDD[i];
-        ptat_sum += data->PTAT[i];
+    // lookup table interpolated to the current ambient temperature
+    const uint16_t *cell = table->TempTable + table_col;
+    for (int row = 0; row < table->NrOfAdElements; row++, cell += table->NrOfTaElements) {
+        plan.column[row] = ((int32_t)cell[0] * table->TaEquidistance +
+                            ((int32_t)cell[1] - (int32_t)cell[0]) * dta) / table->TaEquidistance;
     }
-    data->VDDav = (uint16_t)(vdd_sum / 8);
-    data->PTATav = (uint16_t)(ptat_sum / 8);
+
+    int32_t vdd_delta = data->VDDav - eeprom->VDD_th1 - ((eeprom->VDD_th2 - eeprom->VDD_th1) / (eeprom->PTAT_th2 - eeprom->PTAT_th1)) * (data->PTATav - eeprom->PTAT_th1);
+
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            uint8_t selectRow = (i < HTPA_ROWS / 2) ? i % 4 : i % 4 + 4;
+
+            // Thermal and electrical offset
+            int32_t offset = ((int32_t)eeprom->ThOffset[i][j] + data->electricalOffsets[selectRow][j]) << 8;
+            offset += ((int64_t)eeprom->ThGrad[i][j] * data->PTATav << 8) >> eeprom->gradScale;
+
+            // VDD compensation
+            int64_t vdd_calc_steps = ((int64_t)eeprom->VddCompGrad[selectRow][j] * data->PTATav << 8) >> eeprom->VddScGrad;
+            vdd_calc_steps += (int32_t)eeprom->VddCompOff[selectRow][j] << 8;
+            offset += (vdd_calc_steps * vdd_delta) >> eeprom->VddScOff;
+
+            plan.offset[i][j] = offset;
+        }
+    }
+
+    plan.PTATav = data->PTATav;
+    plan.VDDav = data->VDDav;
+    plan.valid = true;
 }
 
 void HTPA_CalculateTemperatures(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
-    if(data->PTATav == 0 || data->VDDav == 0) return;
+    if(data->PTATav == 0 || data->VDDav == 0) {
+        HTPA_StatsScan(data);
+        return;
+    }
+
+    // Calculate ambient temperature
+    data->ambientTemp = data->PTATav * eeprom->PTAT_gradient + eeprom->PTAT_offset + 0.5f;
+
+    if (!plan.valid || plan.PTATav != data->PTATav || plan.VDDav != data->VDDav) {
+        HTPA_BuildPlan(data, eeprom);
+    }
+
+    const uint8_t ad_shift = table->AdExpBits;
+    const int32_t ad_max = ((table->NrOfAdElements - 1) << (ad_shift + 8)) - 1;
+    const int32_t table_offset = table->TableOffset << 8;
+    const int32_t global_off = eeprom->GlobalOff << 8;
+    HTPA_StatsReset(&data->stats);
+
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        const uint32_t dead = dead_mask[i];
+        for (int j = 0; j < HTPA_COLS; j++) {
+            // Offsets and pixel sensitivity
+            int32_t v = ((int32_t)data->pixelData[i][j] << 8) - plan.offset[i][j];
+            int32_t ad = (((int64_t)v * eeprom->pix_c_recip[i][j]) >> HTPA_RECIP_SHIFT) + table_offset;
+            if (ad < 0) ad = 0;
+            if (ad > ad_max) ad = ad_max;
+
+            // interpolation between the lookup table rows, which are 1 << AdExpBits apart
+            uint16_t table_row = ad >> (ad_shift + 8);
+            int32_t vx = plan.column[table_row];
+            int32_t vy = plan.column[table_row + 1];
+            int32_t temp = (((vy - vx) * (ad & ((1 << (ad_shift + 8)) - 1))) >> ad_shift) + (vx << 8);
+
+            // Apply global offset, round to deci Kelvin
+            int16_t t = (temp + global_off + 128) >> 8;
+            data->pixelTemps[i][j] = t;
+            if (!((dead >> j) & 1)) HTPA_StatsAdd(&data->stats, t, i, j);
+        }
+    }
+}
+#else
+void HTPA_CalculateTemperatures(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
+    HTPA_CalculateTemperaturesDouble(data, eeprom, NULL);
+}
+#endif
 
-    uint16_t table_row, table_col;
+void HTPA_CalculateTemperaturesDouble(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom, double exact[HTPA_ROWS][HTPA_COLS]) {
+    if(data->PTATav == 0 || data->VDDav == 0) {
+        HTPA_StatsScan(data);
+        return;
+    }
+
+    uint16_t table_row, table_col = 0;
     int32_t vx, vy, dta;
 
     // Calculate ambient temperature
-    data->ambientTemp = data->PTATav * eeprom->PTAT_gradient + eeprom->PTAT_offset;
+    double ambientTemp = data->PTATav * eeprom->PTAT_gradient + eeprom->PTAT_offset;
+    data->ambientTemp = ambientTemp + 0.5;
         // printf("PTATav: %d, PTAT_gradient: %.2f, PTAT_offset: %.2f\n", data->PTATav, eeprom->PTAT_gradient, eeprom->PTAT_offset);
-        // printf("    ambientTemp: %.2f\n", data->ambientTemp);
+        // printf("    ambientTemp: %.2f\n", ambientTemp);
 
     // find column of lookup table
-    for (int i = 0; i < NROFTAELEMENTS; i++) {
-        if (data->ambientTemp > XTATemps[i]) {
+    for (int i = 0; i < table->NrOfTaElements; i++) {
+        if (ambientTemp > table->XTATemps[i]) {
             table_col = i;
         }
     }
-    dta = data->ambientTemp - XTATemps[table_col];
+    dta = ambientTemp - table->XTATemps[table_col];
+    const uint8_t cols = table->NrOfTaElements;
+    const double ad_max = ((table->NrOfAdElements - 1) << table->AdExpBits) - 1.0 / 256;
+    HTPA_StatsReset(&data->stats);
 
     for (int i = 0; i < HTPA_ROWS; i++) {
+        const uint32_t dead = dead_mask[i];
         for (int j = 0; j < HTPA_COLS; j++) {
             // Thermal offset
             double v_comp = (data->pixelData[i][j] - (eeprom->ThGrad[i][j] * (double)data->PTATav) / (1 << eeprom->gradScale) - eeprom->ThOffset[i][j]);
@@ -202,26 +528,30 @@ void HTPA_CalculateTemperatures(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
                 // printf("v_vdd_comp: %f\n", v_vdd_comp);
 
             // Pixel sensitivity
-            double v_pixc = ( v_vdd_comp * PCSCALEVAL) / data->pix_c[i][j];
-                // printf("pixc: %d\n", data->pix_c[i][j]);
+            double v_pixc = ( v_vdd_comp * table->PCScaleVal) / eeprom->pix_c[i][j];
+                // printf("pixc: %d\n", eeprom->pix_c[i][j]);
                 // printf("v_pixc: %f\n", v_pixc);
 
-            // Find correct temp for this sensor in lookup table and do a bilinear interpolation
-            table_row = v_pixc + TABLEOFFSET;
-            table_row = table_row >> ADEXPBITS;
+            // Find correct temp for this sensor in lookup table and do a bilinear interpolation,
+            // clamped to the table like the fixed point engine
+            double ad = v_pixc + table->TableOffset;
+            if (ad < 0) ad = 0;
+            if (ad > ad_max) ad = ad_max;
+            table_row = (uint32_t)ad >> table->AdExpBits;
 
             // bilinear interpolation
-            vx = ((((double)TempTable[table_row][table_col + 1] - (double)TempTable[table_row][table_col]) * (double)dta) / (double)TAEQUIDISTANCE) + (double)TempTable[table_row][table_col];
-            vy = ((((double)TempTable[table_row + 1][table_col + 1] - (double)TempTable[table_row + 1][table_col]) * (double)dta) / (double)TAEQUIDISTANCE) + (double)TempTable[table_row + 1][table_col];
-
-            xSemaphoreTake(htpa_mutex, portMAX_DELAY);
-            data->pixelTemps[i][j] = (double)((vy - vx) * ((double)(v_pixc + TABLEOFFSET) - (double)YADValues[table_row]) / (1 << ADEXPBITS) + (double)vx);
-
-            // Apply global offset
-            data->pixelTemps[i][j] = data->pixelTemps[i][j] + eeprom->GlobalOff;
-            data->pixelTemps[i][j] = data->pixelTemps[i][j] / 10.0 - 273.15;
-            xSemaphoreGive(htpa_mutex);
-                // printf("temp: %f\n", data->pixelTemps[i][j]);
+            const uint16_t *x = table->TempTable + table_row * cols + table_col;
+            const uint16_t *y = x + cols;
+            vx = ((((double)x[1] - (double)x[0]) * (double)dta) / (double)table->TaEquidistance) + (double)x[0];
+            vy = ((((double)y[1] - (double)y[0]) * (double)dta) / (double)table->TaEquidistance) + (double)y[0];
+
+            double temp = (double)((vy - vx) * (ad - (double)(table_row << table->AdExpBits)) / (1 << table->AdExpBits) + (double)vx);
+
+            // Apply global offset, round to deci Kelvin
+            data->pixelTemps[i][j] = lround(temp + eeprom->GlobalOff);
+            if (exact) exact[i][j] = temp + eeprom->GlobalOff;
+                // printf("temp: %d\n", data->pixelTemps[i][j]);
+            if (!((dead >> j) & 1)) HTPA_StatsAdd(&data->stats, data->pixelTemps[i][j], i, j);
         }
     }
 }
@@ -323,23 +653,190 @@ void HTPA_PixelMasking(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
         temp_defpix[i] = temp_defpix[i] / number_neighbours[i];
         data->pixelTemps[eeprom->DeadPixAdr[i] >> 5][eeprom->DeadPixAdr[i] % 32] = temp_defpix[i];
     }
+
+    // replaced pixels were left out of the calculation pass
+    for (int i = 0; i < eeprom->NrOfDefPix; i++) {
+        uint8_t row = eeprom->DeadPixAdr[i] >> 5, col = eeprom->DeadPixAdr[i] % 32;
+        HTPA_StatsAdd(&data->stats, data->pixelTemps[row][col], row, col);
+    }
+    HTPA_StatsFinish(&data->stats, data->pixelTemps);
+}
+
+// Weight of the new sample grows by this per deci Kelvin of change above the noise
+#define FILTER_SLOPE ((256 - HTPA_FILTER_MIN_WEIGHT + HTPA_FILTER_MOTION - HTPA_FILTER_NOISE - 1) / (HTPA_FILTER_MOTION - HTPA_FILTER_NOISE))
+
+void HTPA_FilterTemperatures(HTPA_Data_t *data) {
+    const int32_t half = 1 << (HTPA_FILTER_FRAC_BITS - 1);
+
+    // the filtered image replaces the one the statistics were gathered on
+    HTPA_StatsReset(&data->stats);
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            int32_t x = (int32_t)data->pixelTemps[i][j] << HTPA_FILTER_FRAC_BITS;
+            int32_t y = filter_valid ? filter_state[i][j] : x;
+            int32_t d = x - y;
+
+            int32_t w = HTPA_FILTER_MIN_WEIGHT;
+            int32_t motion = (abs(d) >> HTPA_FILTER_FRAC_BITS) - HTPA_FILTER_NOISE;
+            if (motion > 0) w += motion * FILTER_SLOPE;
+            if (w > 256) w = 256;
+            y += (d * w + 128) >> 8;
+            filter_state[i][j] = y;
+
+            int16_t t = (y + half) >> HTPA_FILTER_FRAC_BITS;
+            data->pixelTemps[i][j] = t;
+            HTPA_StatsAdd(&data->stats, t, i, j);
+        }
+    }
+    HTPA_StatsFinish(&data->stats, data->pixelTemps);
+    filter_valid = true;
+}
+
+void HTPA_SetFilter(bool enable) {
+    filter_request = enable;
+}
+
+void HTPA_SetPipelined(bool enable) {
+    pipelined = enable;
+}
+
+void HTPA_SetOversampling(uint8_t frames) {
+    if (frames < 1) frames = 1;
+    if (frames > HTPA_OVERSAMPLE_MAX) frames = HTPA_OVERSAMPLE_MAX;
+    oversample = frames;
+}
+
+uint8_t HTPA_GetOversampling(void) {
+    return oversample;
+}
+
+// Adds the raw frame to the window, returns true once the window is full and
+// data holds the averaged raw frame
+static bool HTPA_Oversample(HTPA_Data_t *data) {
+    // the first frame after power up has no PTAT yet
+    if (data->PTATav == 0 || data->VDDav == 0) return false;
+
+    if (accum.count == 0) {
+        memset(&accum, 0, sizeof(accum));
+        accum.frames = oversample;
+    }
+    accum.PTATav += data->PTATav;
+    accum.VDDav += data->VDDav;
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            accum.pixelData[i][j] += data->pixelData[i][j];
+        }
+    }
+    for (int i = 0; i < HTPA_BLOCKS * 2; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            accum.electricalOffsets[i][j] += data->electricalOffsets[i][j];
+        }
+    }
+    if (++accum.count < accum.frames) return false;
+
+    const uint32_t n = accum.count, half = n / 2;
+    data->PTATav = (accum.PTATav + half) / n;
+    data->VDDav = (accum.VDDav + half) / n;
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            data->pixelData[i][j] = (accum.pixelData[i][j] + half) / n;
+        }
+    }
+    for (int i = 0; i < HTPA_BLOCKS * 2; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            data->electricalOffsets[i][j] = (accum.electricalOffsets[i][j] + half) / n;
+        }
+    }
+    capture_timing.oversampled = n;
+    accum.count = 0;
+    return true;
 }
 
 int HTPA_CaptureData(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
     static uint32_t lastGetVDD = 0;
+    static uint32_t lastGetElOffsets = 0;
+    static uint16_t elOffsetsPTAT = 0;
+    static uint16_t elOffsetsVDD = 0;
+    uint32_t frame_start = micros();
+    memset(&capture_timing, 0, sizeof(capture_timing));
+    if (filter_request != filter_enabled) {
+        // restart instead of fading in from a stale image
+        filter_enabled = filter_request;
+        filter_valid = false;
+    }
+    bool oversampling = (accum.count ? accum.frames : oversample) > 1;
+
+    // electrical offsets drift slowly, refresh them periodically or when PTAT/VDD moved,
+    // oversampling averages them along with every raw frame
+    bool getElOffsets = oversampling ||
+                        millis() - lastGetElOffsets > HTPA_ELOFFSET_PERIOD || lastGetElOffsets == 0 ||
+                        abs(data->PTATav - elOffsetsPTAT) > HTPA_ELOFFSET_PTAT_DRIFT ||
+                        abs(data->VDDav - elOffsetsVDD) > HTPA_ELOFFSET_VDD_DRIFT;
+
     if(millis() - lastGetVDD > HTPA_VDD_PERIOD || lastGetVDD == 0) {
-        CHECK_ERROR(HTPA_GetPixels(data, true));
+        CHECK_ERROR(HTPA_ReadBlocks(data, true, getElOffsets));
         lastGetVDD = millis();
     } else {
-        CHECK_ERROR(HTPA_GetPixels(data, false));
+        CHECK_ERROR(HTPA_ReadBlocks(data, false, getElOffsets));
     }
-    CHECK_ERROR(HTPA_GetElOffsets());
-    HTPA_SortData(data);
+    if (getElOffsets) {
+        CHECK_ERROR(HTPA_GetElOffsets());
+        lastGetElOffsets = millis();
+    }
+    uint32_t calc_start = micros();
+    HTPA_CalculateAverages(data);
+    if (getElOffsets) {
+        HTPA_SortElOffsets(data);
+        elOffsetsPTAT = data->PTATav;
+        elOffsetsVDD = data->VDDav;
+    }
+    // nothing to publish until PTAT and VDD were read once (the first frame
+    // measures VDD only), nor until the window is full
+    if (data->PTATav == 0 || data->VDDav == 0) return HTPA_OK;
+    if (oversampling && !HTPA_Oversample(data)) return HTPA_OK;
     HTPA_CalculateTemperatures(data, eeprom);
     HTPA_PixelMasking(data, eeprom);
+    if (filter_enabled) {
+        HTPA_FilterTemperatures(data);
+    }
+    capture_timing.calc_us = micros() - calc_start;
+    capture_timing.frame_us = micros() - frame_start;
+    HTPA_PublishFrame(data);
     return HTPA_OK;
 }
 
+void HTPA_PublishFrame(const HTPA_Data_t *data) {
+    HTPA_Frame_t *frame = &frames[frame_write];
+    memcpy(frame->pixelTemps, data->pixelTemps, sizeof(frame->pixelTemps));
+    frame->ambientTemp = data->ambientTemp;
+    frame->stats = data->stats;
+    frame->timing = capture_timing;
+    frame->timing.conv_time_us = conv_time_us;
+    frame->frameNumber = ++frame_number;
+    frame_write = atomic_exchange(&frame_exchange, frame_write | FRAME_FRESH) & ~FRAME_FRESH;
+}
+
+void HTPA_CalculatePixelSensitivity(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom) {
+    (void)data;
+    HTPA_CalculateSensitivity(eeprom);
+}
+
+void HTPA_GetTemperatures(const HTPA_Frame_t *frame, float temps[HTPA_ROWS][HTPA_COLS]) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            temps[i][j] = HTPA_DK_TO_C(frame->pixelTemps[i][j]);
+        }
+    }
+}
+
+const HTPA_Frame_t *HTPA_GetLatestFrame(void) {
+    if (!(atomic_load(&frame_exchange) & FRAME_FRESH)) {
+        return NULL;
+    }
+    frame_read = atomic_exchange(&frame_exchange, frame_read) & ~FRAME_FRESH;
+    return &frames[frame_read];
+}
+
 
 /*-------------------------------------------------------------------------------*/
 /* EEPROM Functions                                                              */
@@ -1,6 +1,8 @@
 #ifndef _HTPA_H_
 #define _HTPA_H_
 
+#include <math.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,21 +12,12 @@ extern "C" {
 #include "freertos/event_groups.h"
 #include "esp_event.h"
 
-// Choose sensor model
-#define HTPA32x32dR2L2_1HiSiF5_0_Gain3k3
-// #define HTPA32x32dR2L2_1HiSiF5_0_Gain3k3_Extended
-// #define HTPA32x32dR2L2_1HiSiF5_0_Precise	
-// #define HTPA32x32dR2L2_1SiF5_0_N2
-// #define HTPA32x32dR2L1_6HiGe_Gain3k3
-// #define HTPA32x32dR2L1k8_0k7HiGe	
-// #define HTPA32x32dR2L1k8_0k7HiGe_TaExtended				// same like the above but with a larger working ambient temperature range
-// #define HTPA32x32dR2L2_85Hi_Gain3k3		
-// #define HTPA32x32dR2L3_6HiSi_Rev1_Gain3k3
-// #define HTPA32x32dR2L3_6HiSi_Rev1_Gain3k3_TaExtended		// same like the above but with a larger working ambient temperature range
-// #define HTPA32x32dR2L5_0HiGeF7_7_Gain3k3	
-// #define HTPA32x32dR2L5_0HiGeF7_7_Gain3k3_TaExtended		// same like the above but with a larger working ambient temperature range
-// #define HTPA32x32dR2L5_0HiGeF7_7_Gain3k3_Fever			// higher resolution (not higher accuracy) but limited to Ta between +5 and +50 *C
-// #define HTPA32x32dR2L7_0HiSi_Gain3k3
+// Lookup table variant for sensor models sharing one table number (TN).
+// The table itself is picked at runtime from the TN in the sensor EEPROM.
+#define HTPA_TABLE_STANDARD     0
+#define HTPA_TABLE_TA_EXTENDED  1   // larger working ambient temperature range
+#define HTPA_TABLE_FEVER        2   // higher resolution (not higher accuracy) but limited to Ta between +5 and +50 *C
+#define HTPA_TABLE_VARIANT      HTPA_TABLE_STANDARD
 
 // Device constants
 #define HTPA_ROWS 32
@@ -34,6 +27,57 @@ extern "C" {
 #define HTPA_PIXELS_PER_BLOCK 128
 #define HTPA_VDD_PERIOD      10000
 
+// Blind frame (electrical offsets) refresh period, refreshed earlier when
+// PTATav or VDDav moved by more than the drift thresholds since the last one
+#define HTPA_ELOFFSET_PERIOD        1000
+#define HTPA_ELOFFSET_PTAT_DRIFT    30
+#define HTPA_ELOFFSET_VDD_DRIFT     100
+
+// Start the conversion of the next block as soon as the previous one is latched
+// and read it out while the sensor converts, or read strictly serially.
+// Set at runtime by HTPA_SetPipelined, from the next frame on.
+#define HTPA_PIPELINED_DEFAULT   true
+
+// End of conversion wait: sleep until HTPA_EOC_GUARD_US before the learned
+// conversion time, then poll the status register every HTPA_EOC_POLL_US
+#define HTPA_EOC_GUARD_US    500
+#define HTPA_EOC_POLL_US     50
+
+// Temperature calculation engine: fixed point with per-pixel reciprocal
+// sensitivities, or the reference double implementation
+#define HTPA_CALC_DOUBLE     0
+#define HTPA_CALC_FIXED      1
+#define HTPA_CALC_ENGINE     HTPA_CALC_FIXED
+#define HTPA_RECIP_SHIFT     24
+
+// Frame statistics histogram: HTPA_HIST_BINS bins of 1 << HTPA_HIST_SHIFT deci
+// Kelvin from HTPA_HIST_BASE (-40 *C), the end bins collect everything outside
+#define HTPA_HIST_BINS       256
+#define HTPA_HIST_SHIFT      3
+#define HTPA_HIST_BASE       2332
+
+// Temporal noise filter between masking and publication: per pixel IIR in
+// 1/16 deci Kelvin. A pixel changing by less than HTPA_FILTER_NOISE deci Kelvin
+// takes HTPA_FILTER_MIN_WEIGHT/256 of each new sample, above that the weight
+// grows and reaches 1 (no filtering) at HTPA_FILTER_MOTION deci Kelvin.
+// Enabled at runtime by HTPA_SetFilter, from the next captured frame on.
+#define HTPA_FILTER_DEFAULT      true
+#define HTPA_FILTER_FRAC_BITS    4
+#define HTPA_FILTER_MIN_WEIGHT   32
+#define HTPA_FILTER_NOISE        8
+#define HTPA_FILTER_MOTION       30
+
+// Oversampling: HTPA_CaptureData averages this many raw frames, together with
+// their PTAT, VDD and electrical offsets (a blind frame is read with each), and
+// calibrates and publishes the average once. Set at runtime by HTPA_SetOversampling.
+#define HTPA_OVERSAMPLE_DEFAULT  1
+#define HTPA_OVERSAMPLE_MAX      16
+
+// I2C transactions submitted in one HTPA_I2C_Transfer call, and the bus idle
+// time after waking the sensor up and after loading the trim registers
+#define HTPA_I2C_MAX_BATCH   8
+#define HTPA_TRIM_SETTLE_US  5000
+
 // EEPROM Addresses
 #define EEPROM_PIXC_MIN          0x0000  // PixCmin (float)
 #define EEPROM_PIXC_MAX          0x0004  // PixCmax (float)
@@ -96,7 +140,8 @@ extern "C" {
 
 #define HTPA_OK     0
 #define HTPA_ERR    -1
-#define CHECK_ERROR(err) if (err != 0) { return err; }
+// evaluates err once, a failed call is not repeated
+#define CHECK_ERROR(err) do { int _err = (err); if (_err != 0) { return _err; } } while (0)
 
 typedef struct {
     float PixCmin;
@@ -134,31 +179,122 @@ typedef struct {
     int16_t ThGrad[HTPA_ROWS][HTPA_COLS];
     int16_t ThOffset[HTPA_ROWS][HTPA_COLS];
     uint16_t P[HTPA_ROWS][HTPA_COLS];
+
+    // derived at init by HTPA_CalculateSensitivity
+    double pix_c[HTPA_ROWS][HTPA_COLS];
+    uint32_t pix_c_recip[HTPA_ROWS][HTPA_COLS];
 } HTPA_EEPROM_Data_t;
 
+// Temperatures are kept in deci Kelvin, Celsius converts to the nearest one
+#define HTPA_DK_TO_C(dk)    ((dk) * 0.1f - 273.15f)
+#define HTPA_C_TO_DK(c)     ((int16_t)lroundf((c) * 10.0f + 2731.5f))
+
+// Statistics of a frame, gathered while its temperatures are calculated.
+// Coordinates are in sensor orientation, temperatures in deci Kelvin.
+typedef struct {
+    int16_t minTemp;
+    int16_t maxTemp;
+    uint8_t minRow, minCol;
+    uint8_t maxRow, maxCol;
+    int32_t sum;                        // of all pixels
+    int16_t meanTemp;
+    int16_t centerTemp;                 // mean of the four centre pixels
+    uint16_t hist[HTPA_HIST_BINS];
+} HTPA_Stats_t;
+
 typedef struct {
     uint16_t PTAT[8];
     uint16_t PTATav;
     uint16_t VDD[8];
     uint16_t VDDav;
-    double pix_c[HTPA_ROWS][HTPA_COLS];
     uint16_t pixelData[HTPA_ROWS][HTPA_COLS];
     uint16_t electricalOffsets[HTPA_BLOCKS * 2][HTPA_COLS];
-    double pixelTemps[HTPA_ROWS][HTPA_COLS];
-    double ambientTemp;
+    int16_t pixelTemps[HTPA_ROWS][HTPA_COLS];
+    int16_t ambientTemp;
+    HTPA_Stats_t stats;                 // complete after HTPA_PixelMasking, HTPA_FilterTemperatures
 } HTPA_Data_t;
 
+// Temperature lookup table of one sensor model, see lookuptable.h
+typedef struct {
+    const char *name;
+    uint16_t TN;
+    uint8_t variant;
+    uint8_t NrOfTaElements;
+    uint16_t NrOfAdElements;
+    uint8_t TaEquidistance;
+    uint8_t AdExpBits;
+    uint16_t TableOffset;
+    uint32_t PCScaleVal;
+    const uint16_t *TempTable;      // [NrOfAdElements][NrOfTaElements], rows are 1 << AdExpBits apart
+    const uint16_t *XTATemps;       // [NrOfTaElements]
+} HTPA_Table_t;
+
+// Timing counters of one HTPA_CaptureData call, all times in microseconds
+typedef struct {
+    uint32_t conv_time_us;      // learned conversion time per block
+    uint32_t wait_us;           // total time waiting for end of conversion
+    uint32_t sleep_us;          // part of wait_us spent sleeping
+    uint32_t status_polls;      // status register reads
+    uint32_t transfer_us;       // pixel and blind data readout
+    uint32_t calc_us;           // sorting, calibration, masking and filtering
+    uint8_t oversampled;        // raw frames averaged into the frame, 0 without oversampling
+    uint32_t frame_us;          // whole HTPA_CaptureData
+} HTPA_Timing_t;
+
+// Completed frame handed from the sensor task to its consumer
+typedef struct {
+    int16_t pixelTemps[HTPA_ROWS][HTPA_COLS];
+    int16_t ambientTemp;
+    uint32_t frameNumber;
+    HTPA_Stats_t stats;
+    HTPA_Timing_t timing;               // of the capture that completed the frame
+} HTPA_Frame_t;
+
+// Register read or write, the bus stays idle for settle_us after it
+typedef struct {
+    uint8_t reg;
+    bool read;
+    uint8_t *data;
+    uint16_t len;
+    uint16_t settle_us;
+} HTPA_I2C_Xfer_t;
+
 int HTPA_Init(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom, int i2c_num, int sda_pin, int scl_pin);
 int HTPA_LoadCalibration(HTPA_EEPROM_Data_t *eeprom, bool user_calibration);
-void HTPA_CalculatePixelSensitivity(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom);
+void HTPA_CalculateSensitivity(HTPA_EEPROM_Data_t *eeprom);
 uint8_t HTPA_WaitDataReady(uint32_t timeout_ms);
 int HTPA_GetPixels(HTPA_Data_t *data, bool vdd_meas);
 int HTPA_GetElOffsets();
+void HTPA_BuildSortMap(void);
 void HTPA_SortData(HTPA_Data_t *data);
 void HTPA_CalculateTemperatures(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom);
+// Double precision reference engine, exact (may be NULL) receives the unrounded deci Kelvin
+void HTPA_CalculateTemperaturesDouble(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom, double exact[HTPA_ROWS][HTPA_COLS]);
 void HTPA_PixelMasking(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom);
+void HTPA_FilterTemperatures(HTPA_Data_t *data);
+void HTPA_SetFilter(bool enable);
+void HTPA_SetPipelined(bool enable);
+void HTPA_SetOversampling(uint8_t frames);
+uint8_t HTPA_GetOversampling(void);
 int HTPA_CaptureData(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom);
 
+// Lock-free handoff for one producer and one consumer task. HTPA_GetLatestFrame
+// returns NULL when nothing new was published, the returned frame stays valid
+// until the next call.
+void HTPA_PublishFrame(const HTPA_Data_t *data);
+const HTPA_Frame_t *HTPA_GetLatestFrame(void);
+
+// Adapters for callers still working in degrees Celsius
+static inline float HTPA_GetPixelTemp(const HTPA_Frame_t *frame, uint8_t row, uint8_t col) {
+    return HTPA_DK_TO_C(frame->pixelTemps[row][col]);
+}
+void HTPA_GetTemperatures(const HTPA_Frame_t *frame, float temps[HTPA_ROWS][HTPA_COLS]);
+// old signature, the sensitivities now live in the EEPROM data
+void HTPA_CalculatePixelSensitivity(HTPA_Data_t *data, HTPA_EEPROM_Data_t *eeprom);
+
+const HTPA_Table_t *HTPA_FindTable(uint16_t TN, uint8_t variant);
+const HTPA_Table_t *HTPA_GetTable(void);
+
 int HTPA_ReadEEPROM(HTPA_EEPROM_Data_t *eeprom);
 void HTPA_PrintEEPROM(HTPA_EEPROM_Data_t *eeprom);
 
@@ -168,146 +304,9 @@ extern int HTPA_I2C_DeInit(int i2c_num);
 extern int HTPA_I2C_Write(uint8_t reg, uint8_t *data, uint16_t len);
 extern int HTPA_I2C_Read(uint8_t reg, uint8_t *data, uint16_t len);
 extern int HTPA_EEPROM_Read(uint16_t addr, uint8_t *data, uint16_t len);
-
-#ifdef HTPA32x32dR2L5_0HiGeF7_7_Gain3k3_Fever
-	#define TABLENUMBER		113
-	#define PCSCALEVAL		100000000 //327000000000
-	#define NROFTAELEMENTS 	19
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	25
-	#define ADEXPBITS		3
-	#define TABLEOFFSET		1024 
-#endif		
-
-#ifdef HTPA32x32dR2L5_0HiGeF7_7_Gain3k3
-	#define TABLENUMBER		113
-	#define PCSCALEVAL		100000000 //327000000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024   
-#endif	
-
-#ifdef HTPA32x32dR2L5_0HiGeF7_7_Gain3k3_TaExtended
-	#define TABLENUMBER		113
-	#define PCSCALEVAL		100000000 //327000000000
-	#define NROFTAELEMENTS 	12
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024 
-#endif		
-
-#ifdef HTPA32x32dR2L1_6HiGe_Gain3k3
-	#define TABLENUMBER		119
-	#define PCSCALEVAL		100000000 //327000000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024
-#endif	
-
-#ifdef HTPA32x32dR2L2_1SiF5_0_N2
-	#define TABLENUMBER		130
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		192  
-#endif	
-
-#ifdef HTPA32x32dR2L2_1HiSiF5_0_Gain3k3
-	#define TABLENUMBER		114
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024
-#endif	
-
-#ifdef HTPA32x32dR2L2_1HiSiF5_0_Gain3k3_Extended
-	#define TABLENUMBER		114
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	12
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1792
-#endif	
-
-#ifdef HTPA32x32dR2L2_1HiSiF5_0_Precise
-	#define TABLENUMBER		116
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	22
-	#define NROFADELEMENTS 	1000
-	#define TAEQUIDISTANCE	50
-	#define ADEXPBITS		5
-	#define TABLEOFFSET		1024  
-#endif	
-
-#ifdef HTPA32x32dR2L2_85Hi_Gain3k3
-	#define TABLENUMBER		127
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024  
-#endif	
-
-#ifdef HTPA32x32dR2L3_6HiSi_Rev1_Gain3k3
-	#define TABLENUMBER		117
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024
-#endif	
-
-#ifdef HTPA32x32dR2L3_6HiSi_Rev1_Gain3k3_TaExtended
-	#define TABLENUMBER		117
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	12
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024
-#endif		
-
-#ifdef HTPA32x32dR2L7_0HiSi_Gain3k3
-	#define TABLENUMBER		118
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	7
-	#define NROFADELEMENTS 	1595
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		640
-#endif	
-
-#ifdef HTPA32x32dR2L1k8_0k7HiGe
-	#define TABLENUMBER		115	
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	10
-	#define NROFADELEMENTS 	471
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024
-#endif	
-
-#ifdef HTPA32x32dR2L1k8_0k7HiGe_TaExtended
-	#define TABLENUMBER		115	
-	#define PCSCALEVAL		100000000
-	#define NROFTAELEMENTS 	12
-	#define NROFADELEMENTS 	471
-	#define TAEQUIDISTANCE	100
-	#define ADEXPBITS		6
-	#define TABLEOFFSET		1024 
-#endif	
+// Runs the transactions in order; the ones without settle time in between
+// should be queued to the bus as one unit
+extern int HTPA_I2C_Transfer(const HTPA_I2C_Xfer_t *xfer, uint8_t count);
 
 #ifdef __cplusplus
 }
@@ -1,6 +1,12 @@
+// ESP-IDF I2C driver behind the HTPA_I2C_* hooks, host tests bring their own
+#ifdef ESP_PLATFORM
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "driver/i2c.h"
+#include "esp32-hal.h"
+#include "esp_idf_version.h"
+#include "htpa.h"
 
 #define HTPA_DEV_ADR       0x1A
 #define HTPA_EEPROM_ADR    0x50
@@ -8,6 +14,18 @@
 
 static int i2c_port = I2C_NUM_0;
 
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0)
+// Command links are built in this buffer instead of the heap. Only the sensor
+// task talks to the bus, so one buffer is enough.
+static uint8_t cmd_buffer[I2C_LINK_RECOMMENDED_SIZE(HTPA_I2C_MAX_BATCH * 2)];
+#define HTPA_I2C_CmdCreate()     i2c_cmd_link_create_static(cmd_buffer, sizeof(cmd_buffer))
+#define HTPA_I2C_CmdDelete(cmd)  i2c_cmd_link_delete_static(cmd)
+#else
+// older IDF has no static command links
+#define HTPA_I2C_CmdCreate()     i2c_cmd_link_create()
+#define HTPA_I2C_CmdDelete(cmd)  i2c_cmd_link_delete(cmd)
+#endif
+
 int HTPA_I2C_Init(int i2c_num, int sda_pin, int scl_pin, uint32_t clk_speed) {
     int ret = 0;
     i2c_port = i2c_num;
@@ -36,56 +54,82 @@ int HTPA_I2C_DeInit(i2c_port_t i2c_num) {
     return i2c_driver_delete(i2c_num);
 }
 
-int HTPA_I2C_Read(uint8_t reg, uint8_t *data, uint16_t len) {
-    int ret = 0;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (HTPA_DEV_ADR << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg, true);
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (HTPA_DEV_ADR << 1) | I2C_MASTER_READ, true);
-    i2c_master_read(cmd, data, len, I2C_MASTER_LAST_NACK);  
-    i2c_master_stop(cmd);
-
-    ret = i2c_master_cmd_begin(i2c_port, cmd, 1000 / portTICK_RATE_MS);
-    if (ret != ESP_OK) return ret;
+static void HTPA_I2C_Settle(uint16_t settle_us) {
+    if (settle_us >= 1000) vTaskDelay(settle_us / 1000 / portTICK_PERIOD_MS);
+    if (settle_us % 1000) delayMicroseconds(settle_us % 1000);
+}
 
-    i2c_cmd_link_delete(cmd);
+// Appends a register transaction to the command link, returns the first error
+// of the i2c_master_* calls (out of link buffer or bad arguments)
+static esp_err_t HTPA_I2C_Queue(i2c_cmd_handle_t cmd, uint8_t dev, const uint8_t *reg, uint8_t reg_len,
+                                bool read, uint8_t *data, uint16_t len) {
+    esp_err_t ret = i2c_master_start(cmd);
+    if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, (dev << 1) | I2C_MASTER_WRITE, true);
+    for (uint8_t i = 0; i < reg_len && ret == ESP_OK; i++) {
+        ret = i2c_master_write_byte(cmd, reg[i], true);
+    }
+    if (read) {
+        if (ret == ESP_OK) ret = i2c_master_start(cmd);
+        if (ret == ESP_OK) ret = i2c_master_write_byte(cmd, (dev << 1) | I2C_MASTER_READ, true);
+        if (ret == ESP_OK) ret = i2c_master_read(cmd, data, len, I2C_MASTER_LAST_NACK);
+    } else if (ret == ESP_OK) {
+        ret = i2c_master_write(cmd, data, len, true);
+    }
     return ret;
 }
 
-int HTPA_I2C_Write(uint8_t reg, uint8_t *data, uint16_t len) {
-    int ret = 0;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (HTPA_DEV_ADR << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg, true);
-    i2c_master_write(cmd, data, len, true);
-    i2c_master_stop(cmd);
-
-    ret = i2c_master_cmd_begin(i2c_port, cmd, I2C_TIMOUT_MS / portTICK_RATE_MS);
-    if (ret != ESP_OK) return ret;
+// Stops and runs the command link unless building it failed, frees it either way
+static int HTPA_I2C_Submit(i2c_cmd_handle_t cmd, esp_err_t ret) {
+    if (ret == ESP_OK) ret = i2c_master_stop(cmd);
+    if (ret == ESP_OK) ret = i2c_master_cmd_begin(i2c_port, cmd, I2C_TIMOUT_MS / portTICK_RATE_MS);
+    HTPA_I2C_CmdDelete(cmd);
+    return ret;
+}
 
-    i2c_cmd_link_delete(cmd);
-    vTaskDelay(5 / portTICK_PERIOD_MS);
+int HTPA_I2C_Transfer(const HTPA_I2C_Xfer_t *xfer, uint8_t count) {
+    esp_err_t ret = ESP_OK;
+    i2c_cmd_handle_t cmd = 0;
+
+    if (count > HTPA_I2C_MAX_BATCH) return ESP_FAIL;
+
+    // transactions without settle time in between go out as one command link,
+    // a NACK anywhere fails the whole batch
+    for (uint8_t i = 0; i < count; i++) {
+        if (!cmd) {
+            cmd = HTPA_I2C_CmdCreate();
+            if (!cmd) return ESP_FAIL;
+        } else {
+            ret = i2c_master_stop(cmd);
+        }
+        if (ret == ESP_OK) {
+            ret = HTPA_I2C_Queue(cmd, HTPA_DEV_ADR, &xfer[i].reg, 1, xfer[i].read, xfer[i].data, xfer[i].len);
+        }
+
+        if (ret != ESP_OK || xfer[i].settle_us || i + 1 == count) {
+            ret = HTPA_I2C_Submit(cmd, ret);
+            cmd = 0;
+            if (ret != ESP_OK) return ret;
+            HTPA_I2C_Settle(xfer[i].settle_us);
+        }
+    }
     return ret;
 }
 
+int HTPA_I2C_Read(uint8_t reg, uint8_t *data, uint16_t len) {
+    HTPA_I2C_Xfer_t xfer = { .reg = reg, .read = true, .data = data, .len = len };
+    return HTPA_I2C_Transfer(&xfer, 1);
+}
+
+int HTPA_I2C_Write(uint8_t reg, uint8_t *data, uint16_t len) {
+    HTPA_I2C_Xfer_t xfer = { .reg = reg, .read = false, .data = data, .len = len };
+    return HTPA_I2C_Transfer(&xfer, 1);
+}
+
 int HTPA_EEPROM_Read(uint16_t addr, uint8_t *data, uint16_t len) {
-    int ret = 0;
     uint8_t hi_lo[] = { (uint8_t)(addr >> 8), (uint8_t)addr };
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (HTPA_EEPROM_ADR << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write(cmd, hi_lo, 2, true);
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (HTPA_EEPROM_ADR << 1) | I2C_MASTER_READ, true);
-    i2c_master_read(cmd, data, len, I2C_MASTER_LAST_NACK);  
-    i2c_master_stop(cmd);
-
-    ret = i2c_master_cmd_begin(i2c_port, cmd, 1000 / portTICK_RATE_MS);
-    if (ret != ESP_OK) return ret;
-
-    i2c_cmd_link_delete(cmd);
-    return ret;
+    i2c_cmd_handle_t cmd = HTPA_I2C_CmdCreate();
+    if (!cmd) return ESP_FAIL;
+    return HTPA_I2C_Submit(cmd, HTPA_I2C_Queue(cmd, HTPA_EEPROM_ADR, hi_lo, 2, true, data, len));
 }
+
+#endif
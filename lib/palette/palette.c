@@ -2,15 +2,13 @@
 #include "freertos/task.h"
 #include "palette.h"
 
-static tRGBcolor *getIronPalette(uint16_t steps)
-{
-    if (steps % 4)
-    	steps = (steps / 4) * 4 + 4;
-
-    tRGBcolor *Buffer = heap_caps_malloc(steps * sizeof(tRGBcolor), MALLOC_CAP_8BIT);
-	if (!Buffer)
-	    return 0;
+// Fixed size tables, built once per palette on first use
+static uint16_t PaletteTable[PALETTE_COUNT][2][PALETTE_SIZE];
+static bool PaletteTableReady[PALETTE_COUNT];
 
+// steps must be a multiple of 4
+static void fillIronPalette(tRGBcolor *Buffer, uint16_t steps)
+{
 	uint16_t partSize = steps >> 2;
 	tRGBcolor KeyColors[5] =
 	{
@@ -35,7 +33,18 @@ static tRGBcolor *getIronPalette(uint16_t steps)
 	    	pPalette++;
 		}
 	}
+}
+
+static tRGBcolor *getIronPalette(uint16_t steps)
+{
+    if (steps % 4)
+    	steps = (steps / 4) * 4 + 4;
 
+    tRGBcolor *Buffer = heap_caps_malloc(steps * sizeof(tRGBcolor), MALLOC_CAP_8BIT);
+	if (!Buffer)
+	    return 0;
+
+	fillIronPalette(Buffer, steps);
 	return Buffer;
 }
 
@@ -55,3 +64,30 @@ void freePalette(tRGBcolor *pPalette)
 	if (pPalette)
 		heap_caps_free(pPalette);
 }
+
+const uint16_t *getPaletteTable(uint8_t paletteNum, bool swapBytes)
+{
+	if (paletteNum >= PALETTE_COUNT)
+		return 0;
+
+	if (!PaletteTableReady[paletteNum])
+	{
+		tRGBcolor Colors[PALETTE_SIZE];
+		switch (paletteNum)
+		{
+			case PALETTE_IRON:
+				fillIronPalette(Colors, PALETTE_SIZE);
+				break;
+		}
+
+		for (uint16_t i = 0; i < PALETTE_SIZE; i++)
+		{
+			uint16_t color = RGB565(Colors[i].r, Colors[i].g, Colors[i].b);
+			PaletteTable[paletteNum][0][i] = color;
+			PaletteTable[paletteNum][1][i] = RGB565_SWAP(color);
+		}
+		PaletteTableReady[paletteNum] = true;
+	}
+
+	return PaletteTable[paletteNum][swapBytes ? 1 : 0];
+}
@@ -5,6 +5,9 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
+
 typedef struct
 {
 	uint8_t r;
@@ -13,10 +16,20 @@ typedef struct
 } tRGBcolor;
 
 #define PALETTE_IRON	0
+#define PALETTE_COUNT	1
+
+// Entries of the fixed size tables, the temperature range is mapped onto them
+#define PALETTE_SIZE	256
+
+// RGB565 as the display expects it, swapped for raw 16-bit framebuffer writes
+#define RGB565(r, g, b)		((uint16_t)((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+#define RGB565_SWAP(c)		((uint16_t)(((c) >> 8) | ((c) << 8)))
 
 tRGBcolor *getPalette(uint8_t paletteNum, uint16_t steps);
 void freePalette(tRGBcolor *pPalette);
 
+const uint16_t *getPaletteTable(uint8_t paletteNum, bool swapBytes);
+
 #ifdef __cplusplus
 }
 #endif
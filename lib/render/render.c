@@ -0,0 +1,101 @@
+#include "render.h"
+#include <string.h>
+
+int Render_StreamInit(Render_Stream_t *stream, uint16_t *buf0, uint16_t *buf1, uint16_t width, uint16_t bandHeight, Render_FlushFn flush, void *arg) {
+    if (!stream || !buf0 || !buf1 || !flush) return HTPA_ERR;
+
+    uint16_t *buf[2] = { buf0, buf1 };
+    for (uint8_t n = 0; n < 2; n++) {
+        stream->band[n].buf = buf[n];
+        stream->band[n].width = width;
+        stream->band[n].height = bandHeight;
+        stream->band[n].stride = width;
+    }
+    stream->current = 0;
+    stream->flush = flush;
+    stream->arg = arg;
+    return HTPA_OK;
+}
+
+void Render_StreamFlush(Render_Stream_t *stream, uint16_t x, uint16_t y, uint16_t rows) {
+    stream->flush(&stream->band[stream->current], x, y, rows, stream->arg);
+    stream->current ^= 1;
+}
+
+void Render_DeltaInit(Render_Delta_t *delta, uint8_t before, uint8_t after) {
+    memset(delta, 0, sizeof(*delta));
+    delta->before = before;
+    delta->after = after;
+}
+
+uint16_t Render_DeltaUpdate(Render_Delta_t *delta, const int16_t src[HTPA_ROWS][HTPA_COLS], bool mirror, const Render_Map_t *map, bool full) {
+    uint32_t changed[HTPA_ROWS];
+
+    if (!delta->valid || delta->map.palette != map->palette || delta->map.size != map->size ||
+        delta->map.base != map->base || delta->map.span != map->span || delta->map.curve != map->curve) {
+        full = true;
+    }
+    delta->valid = true;
+    delta->map = *map;
+
+    for (int row = 0; row < HTPA_ROWS; row++) {
+        changed[row] = full ? UINT32_MAX : 0;
+        for (int col = 0; col < HTPA_COLS; col++) {
+            uint16_t idx = Render_MapIndex(map, src[row][mirror ? HTPA_COLS - col - 1 : col]);
+            if (delta->index[row][col] != idx) {
+                delta->index[row][col] = idx;
+                changed[row] |= 1UL << col;
+            }
+        }
+    }
+
+    // spread every changed cell over the blocks whose interpolation reads it
+    uint16_t count = 0;
+    for (int row = 0; row < HTPA_ROWS; row++) {
+        uint32_t mask = 0;
+        for (int k = -delta->before; k <= delta->after; k++) {
+            if (row + k < 0 || row + k >= HTPA_ROWS) continue;
+            mask |= changed[row + k];
+        }
+        uint32_t dirty = mask;
+        for (int k = 1; k <= delta->before; k++) dirty |= mask << k;
+        for (int k = 1; k <= delta->after; k++) dirty |= mask >> k;
+        delta->dirty[row] = dirty;
+        count += __builtin_popcount(dirty);
+    }
+    return count;
+}
+
+void Render_DeltaMarkRect(Render_Delta_t *delta, const Render_Layout_t *layout, int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    int16_t x1 = x + w, y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > layout->width) x1 = layout->width;
+    if (y1 > layout->height) y1 = layout->height;
+    if (x >= x1 || y >= y1) return;
+
+    // tiles holding the first and last pixel of the rectangle
+    uint16_t col0 = (uint32_t)x * HTPA_COLS / layout->width, col1 = (uint32_t)(x1 - 1) * HTPA_COLS / layout->width;
+    uint16_t row0 = (uint32_t)y * HTPA_ROWS / layout->height, row1 = (uint32_t)(y1 - 1) * HTPA_ROWS / layout->height;
+
+    uint32_t mask = (UINT32_MAX >> (31 - col1)) & (UINT32_MAX << col0);
+    for (uint16_t row = row0; row <= row1; row++) {
+        delta->dirty[row] |= mask;
+    }
+}
+
+void Render_MapInit(Render_Map_t *map, const uint16_t *palette, uint16_t size, int16_t minTemp, int16_t maxTemp) {
+    map->palette = palette;
+    map->size = size;
+    map->base = minTemp;
+    map->span = (maxTemp > minTemp) ? maxTemp - minTemp : 1;
+    map->gain = ((uint32_t)size << 16) / map->span;
+    map->curve = NULL;
+    map->shift = 0;
+}
+
+void Render_Colorize(const int16_t *src, uint16_t *dst, uint16_t count, const Render_Map_t *map) {
+    for (uint16_t i = 0; i < count; i++) {
+        dst[i] = map->palette[Render_MapIndex(map, src[i])];
+    }
+}
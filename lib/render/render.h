@@ -0,0 +1,243 @@
+#ifndef _RENDER_H_
+#define _RENDER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "htpa.h"
+#include "freertos/semphr.h"
+
+#define RENDER_WEIGHT_BITS      8
+#define RENDER_WEIGHT_ONE       (1 << RENDER_WEIGHT_BITS)
+#define RENDER_MAX_TAPS         4
+#define RENDER_MAX_WIDTH        320
+#define RENDER_MAX_HEIGHT       240
+
+#define RENDER_ENGINE_NEAREST   0
+#define RENDER_ENGINE_BILINEAR  1
+#define RENDER_ENGINE_BICUBIC   2
+#define RENDER_ENGINE_COUNT     3
+
+// Interpolation kernel. Output pixel x maps to source position
+// u = x * 32 / width and reads taps source cells from floor(u) - before on.
+typedef struct {
+    const char *name;
+    uint8_t taps;
+    uint8_t before;
+    uint8_t after;
+    int16_t (*weight)(int32_t t);                   // Q8 weight at distance t (Q8) from the tap
+} Render_Engine_t;
+
+extern const Render_Engine_t Render_Engines[RENDER_ENGINE_COUNT];
+
+// Source cells and Q8 weights of every output column and row, built once per
+// engine and output size, any size up to the maximum. Mirroring is folded
+// into the column indices. Output pixels sampling the same cell at floor(u)
+// form the tile of that cell.
+typedef struct {
+    const Render_Engine_t *engine;
+    uint16_t width;
+    uint16_t height;
+    uint16_t colStart[HTPA_COLS + 1];               // first output column of each tile column
+    uint16_t rowStart[HTPA_ROWS + 1];               // first output row of each tile row
+    uint8_t colSrc[RENDER_MAX_WIDTH][RENDER_MAX_TAPS];
+    int16_t colWeight[RENDER_MAX_WIDTH][RENDER_MAX_TAPS];
+    uint8_t rowSrc[RENDER_MAX_HEIGHT][RENDER_MAX_TAPS];
+    int16_t rowWeight[RENDER_MAX_HEIGHT][RENDER_MAX_TAPS];
+} Render_Layout_t;
+
+// Separable upscaler of a sensor frame, one per rendering thread. Source rows
+// are interpolated horizontally once into scratch lines, output rows are
+// blended from the lines around them. All values in deci Kelvin.
+typedef struct {
+    const Render_Layout_t *layout;
+    const int16_t (*src)[HTPA_COLS];
+    int8_t lineRow[RENDER_MAX_TAPS];                // source row held by each line, -1 if none
+    int32_t line[RENDER_MAX_TAPS][RENDER_MAX_WIDTH];    // Q8 horizontally interpolated source rows
+} Render_Scaler_t;
+
+// Raw 16-bit framebuffer rendered into, pixels already in display byte order
+typedef struct {
+    uint16_t *buf;
+    uint16_t width;
+    uint16_t height;
+    uint16_t stride;                                // pixels between row starts
+} Render_Target_t;
+
+static inline uint16_t *Render_TargetRow(const Render_Target_t *target, uint16_t y) {
+    return target->buf + (uint32_t)y * target->stride;
+}
+
+// Hands a finished band over to the display, e.g. by starting a DMA transfer.
+// It must not return before the transfer of the previous band is done.
+typedef void (*Render_FlushFn)(Render_Target_t *band, uint16_t x, uint16_t y, uint16_t rows, void *arg);
+
+// Image streamed in horizontal bands through two ping-pong buffers, one is
+// rendered while the other is being transferred
+typedef struct {
+    Render_Target_t band[2];
+    uint8_t current;
+    Render_FlushFn flush;
+    void *arg;
+} Render_Stream_t;
+
+int Render_StreamInit(Render_Stream_t *stream, uint16_t *buf0, uint16_t *buf1, uint16_t width, uint16_t bandHeight, Render_FlushFn flush, void *arg);
+// Next band to render into, packed to width pixels per row (at most the init width)
+static inline Render_Target_t *Render_StreamBand(Render_Stream_t *stream, uint16_t width) {
+    Render_Target_t *band = &stream->band[stream->current];
+    band->width = width;
+    band->stride = width;
+    return band;
+}
+void Render_StreamFlush(Render_Stream_t *stream, uint16_t x, uint16_t y, uint16_t rows);
+
+int Render_LayoutInit(Render_Layout_t *layout, uint8_t engine, uint16_t width, uint16_t height, bool mirror);
+void Render_ScalerBegin(Render_Scaler_t *scaler, const Render_Layout_t *layout, const int16_t src[HTPA_ROWS][HTPA_COLS]);
+void Render_ScalerRow(Render_Scaler_t *scaler, uint16_t row, uint16_t x, uint16_t count, int16_t *out);
+
+// Maps deci Kelvin temperatures onto a fixed size palette, linearly or along
+// a curve of palette indices every 1 << shift deci Kelvin, interpolated
+typedef struct {
+    const uint16_t *palette;
+    uint16_t size;
+    int16_t base;                                   // temperature of entry 0
+    uint16_t span;                                  // temperature range covered by the palette
+    uint32_t gain;                                  // Q16 entries per deci Kelvin
+    const uint16_t *curve;                          // span >> shift + 1 indices, NULL for linear
+    uint8_t shift;
+} Render_Map_t;
+
+void Render_MapInit(Render_Map_t *map, const uint16_t *palette, uint16_t size, int16_t minTemp, int16_t maxTemp);
+
+static inline uint16_t Render_MapIndex(const Render_Map_t *map, int16_t temp) {
+    int32_t d = temp - map->base;
+    if (d <= 0) return 0;
+    if (d >= map->span) return map->size - 1;
+    if (map->curve) {
+        const uint16_t *c = map->curve + (d >> map->shift);
+        int32_t frac = d & ((1 << map->shift) - 1);
+        return c[0] + ((((int32_t)c[1] - c[0]) * frac) >> map->shift);
+    }
+    return ((uint32_t)d * map->gain) >> 16;
+}
+
+// Histogram equalising AGC on the frame statistics histogram. Bins are clipped
+// to the plateau so large uniform areas don't take the whole palette. The curve
+// follows the equalised one at rate/256 per frame and is handed to the map only
+// when it moved threshold palette entries away from the one in use.
+#define RENDER_AGC_POINTS   (HTPA_HIST_BINS + 1)
+
+typedef struct {
+    const uint16_t *palette;
+    uint16_t size;
+    uint16_t plateau;                               // pixels per bin, 0 for plain equalisation
+    uint8_t rate;
+    uint8_t threshold;
+    bool valid;
+    uint8_t current;
+    int32_t smooth[RENDER_AGC_POINTS];              // Q8 palette index at each bin edge
+    uint16_t curve[2][RENDER_AGC_POINTS];           // in use by the map and the next one
+} Render_Agc_t;
+
+void Render_AgcInit(Render_Agc_t *agc, const uint16_t *palette, uint16_t size, uint16_t plateau, uint8_t rate, uint8_t threshold);
+// Returns true when the map got a new curve
+bool Render_AgcUpdate(Render_Agc_t *agc, const HTPA_Stats_t *stats, Render_Map_t *map);
+
+// Linear scale range following the scene. The coldest and hottest ignore
+// pixels are left out, the range grows at attack/256 and shrinks at decay/256
+// of the distance per frame, and only shrinks once the scene is more than
+// hysteresis deci Kelvin inside it.
+typedef struct {
+    uint16_t ignore;
+    uint8_t attack;
+    uint8_t decay;
+    int16_t hysteresis;
+    int16_t minSpan;                                // deci Kelvin
+    bool valid;
+    int32_t low;                                    // Q8 deci Kelvin
+    int32_t high;
+} Render_Autoscale_t;
+
+void Render_AutoscaleInit(Render_Autoscale_t *scale, uint16_t ignore, uint8_t attack, uint8_t decay, int16_t hysteresis, int16_t minSpan);
+void Render_AutoscaleUpdate(Render_Autoscale_t *scale, const HTPA_Stats_t *stats, int16_t *minTemp, int16_t *maxTemp);
+
+// Tracks which output tiles (see Render_Layout_t, one per source cell) have
+// to be redrawn. Cells are compared at palette index, the display quantisation,
+// in display orientation. A block reading cells before..after of its own
+// position is dirty when any of them changed.
+typedef struct {
+    bool valid;
+    uint8_t before;
+    uint8_t after;
+    Render_Map_t map;
+    uint16_t index[HTPA_ROWS][HTPA_COLS];
+    uint32_t dirty[HTPA_ROWS];                      // dirty tiles of each tile row, bit = column
+} Render_Delta_t;
+
+void Render_DeltaInit(Render_Delta_t *delta, uint8_t before, uint8_t after);
+uint16_t Render_DeltaUpdate(Render_Delta_t *delta, const int16_t src[HTPA_ROWS][HTPA_COLS], bool mirror, const Render_Map_t *map, bool full);
+void Render_DeltaMarkRect(Render_Delta_t *delta, const Render_Layout_t *layout, int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+// Part of a render job, e.g. a range of rows of the current band
+typedef void (*Render_JobFn)(void *arg, uint16_t first, uint16_t count);
+
+// Task on the other core running one job at a time for the caller. Without a
+// task (not started or failed to start) jobs run inline in the caller.
+typedef struct {
+    TaskHandle_t task;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    Render_JobFn fn;
+    void *arg;
+    uint16_t first;
+    uint16_t count;
+} Render_Worker_t;
+
+int Render_WorkerStart(Render_Worker_t *worker, const char *name, UBaseType_t priority, BaseType_t core);
+void Render_WorkerRun(Render_Worker_t *worker, Render_JobFn fn, void *arg, uint16_t first, uint16_t count);
+void Render_WorkerJoin(Render_Worker_t *worker);
+
+void Render_Colorize(const int16_t *src, uint16_t *dst, uint16_t count, const Render_Map_t *map);
+
+#define RENDER_OVERLAY_MAX_ITEMS    24
+#define RENDER_OVERLAY_MAX_TEXT     12
+// 5x7 glyphs in a 6x8 cell, multiplied by the text scale
+#define RENDER_CHAR_WIDTH           6
+#define RENDER_CHAR_HEIGHT          8
+
+typedef struct {
+    bool text;
+    uint8_t scale;
+    int16_t x;
+    int16_t y;
+    uint16_t w;                                     // rectangle size or text extent
+    uint16_t h;
+    uint16_t color;                                 // RGB565, swapped to display order when drawn
+    char str[RENDER_OVERLAY_MAX_TEXT];
+} Render_OverlayItem_t;
+
+// Rectangles and text rasterised into render targets in the order added,
+// so they travel with the image instead of being drawn on the panel after it
+typedef struct {
+    uint8_t count;
+    Render_OverlayItem_t item[RENDER_OVERLAY_MAX_ITEMS];
+} Render_Overlay_t;
+
+void Render_OverlayClear(Render_Overlay_t *overlay);
+void Render_OverlayRect(Render_Overlay_t *overlay, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void Render_OverlayText(Render_Overlay_t *overlay, int16_t x, int16_t y, const char *str, uint8_t scale, uint16_t color);
+bool Render_OverlayBounds(const Render_Overlay_t *overlay, int16_t *x, int16_t *y, uint16_t *w, uint16_t *h);
+// Draws the items over target, whose first pixel is at (x, y) in overlay coordinates
+void Render_OverlayComposite(const Render_Overlay_t *overlay, Render_Target_t *target, int16_t x, int16_t y);
+
+uint16_t Render_TextWidth(const char *str, uint8_t scale);
+void Render_Fill(Render_Target_t *target, uint16_t color);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
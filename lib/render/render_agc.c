@@ -0,0 +1,77 @@
+#include "render.h"
+#include <string.h>
+
+void Render_AgcInit(Render_Agc_t *agc, const uint16_t *palette, uint16_t size, uint16_t plateau, uint8_t rate, uint8_t threshold) {
+    memset(agc, 0, sizeof(*agc));
+    agc->palette = palette;
+    agc->size = size;
+    agc->plateau = plateau;
+    agc->rate = rate ? rate : 1;
+    agc->threshold = threshold;
+}
+
+static uint16_t Render_AgcBin(int16_t temp) {
+    int32_t bin = (temp - HTPA_HIST_BASE) >> HTPA_HIST_SHIFT;
+    if (bin < 0) return 0;
+    if (bin > HTPA_HIST_BINS - 1) return HTPA_HIST_BINS - 1;
+    return bin;
+}
+
+bool Render_AgcUpdate(Render_Agc_t *agc, const HTPA_Stats_t *stats, Render_Map_t *map) {
+    const int32_t top = (int32_t)(agc->size - 1) << 8;
+    uint16_t first = Render_AgcBin(stats->minTemp);
+    uint16_t last = Render_AgcBin(stats->maxTemp);
+
+    // only the occupied bins contribute, the curve is flat outside them
+    uint32_t total = 0;
+    for (uint16_t k = first; k <= last; k++) {
+        uint16_t n = stats->hist[k];
+        total += (agc->plateau && n > agc->plateau) ? agc->plateau : n;
+    }
+    if (total == 0) total = 1;
+
+    int32_t max_step = 0;
+    uint32_t cum = 0;
+    for (uint16_t k = 0; k < RENDER_AGC_POINTS; k++) {
+        // equalised Q8 index at the lower edge of bin k
+        int32_t target;
+        if (k <= first) {
+            target = 0;
+        } else if (k > last) {
+            target = top;
+        } else {
+            target = (cum * top) / total;
+        }
+        if (k >= first && k <= last) {
+            uint16_t n = stats->hist[k];
+            cum += (agc->plateau && n > agc->plateau) ? agc->plateau : n;
+        }
+
+        int32_t v = agc->valid ? agc->smooth[k] + (((target - agc->smooth[k]) * agc->rate) >> 8) : target;
+        agc->smooth[k] = v;
+
+        int32_t step = ((v + 128) >> 8) - agc->curve[agc->current][k];
+        if (step < 0) step = -step;
+        if (step > max_step) max_step = step;
+    }
+
+    // a new curve redraws the whole image, so small drifts wait
+    bool changed = !agc->valid || max_step >= agc->threshold;
+    if (changed) {
+        uint16_t *curve = agc->curve[agc->current ^ 1];
+        for (uint16_t k = 0; k < RENDER_AGC_POINTS; k++) {
+            curve[k] = (agc->smooth[k] + 128) >> 8;
+        }
+        agc->current ^= 1;
+        agc->valid = true;
+    }
+
+    map->palette = agc->palette;
+    map->size = agc->size;
+    map->base = HTPA_HIST_BASE;
+    map->span = HTPA_HIST_BINS << HTPA_HIST_SHIFT;
+    map->gain = 0;
+    map->curve = agc->curve[agc->current];
+    map->shift = HTPA_HIST_SHIFT;
+    return changed;
+}
@@ -0,0 +1,73 @@
+#include "render.h"
+#include <string.h>
+
+void Render_AutoscaleInit(Render_Autoscale_t *scale, uint16_t ignore, uint8_t attack, uint8_t decay, int16_t hysteresis, int16_t minSpan) {
+    memset(scale, 0, sizeof(*scale));
+    scale->ignore = ignore;
+    scale->attack = attack ? attack : 1;
+    scale->decay = decay ? decay : 1;
+    scale->hysteresis = hysteresis;
+    scale->minSpan = minSpan;
+}
+
+// Temperature with count pixels below it (or above it from the top), read
+// from the histogram and interpolated inside the bin
+static int16_t Render_HistLevel(const HTPA_Stats_t *stats, uint16_t count, bool top) {
+    if (count == 0) return top ? stats->maxTemp : stats->minTemp;
+
+    uint16_t cum = 0;
+    int32_t level = top ? stats->minTemp : stats->maxTemp;
+    for (uint16_t n = 0; n < HTPA_HIST_BINS; n++) {
+        uint16_t k = top ? HTPA_HIST_BINS - 1 - n : n;
+        uint16_t hits = stats->hist[k];
+        if (cum + hits > count) {
+            int32_t edge = HTPA_HIST_BASE + ((int32_t)k << HTPA_HIST_SHIFT);
+            int32_t part = ((int32_t)(count - cum) << HTPA_HIST_SHIFT) / hits;
+            level = top ? edge + (1 << HTPA_HIST_SHIFT) - part : edge + part;
+            break;
+        }
+        cum += hits;
+    }
+    if (level < stats->minTemp) level = stats->minTemp;
+    if (level > stats->maxTemp) level = stats->maxTemp;
+    return level;
+}
+
+static int32_t Render_AutoscaleStep(const Render_Autoscale_t *scale, int32_t bound, int32_t target, bool upper) {
+    int32_t grow = upper ? target - bound : bound - target;
+    int32_t inside = -grow - ((int32_t)scale->hysteresis << 8);
+
+    if (grow > 0) {
+        grow = (grow * scale->attack + 255) >> 8;
+        return upper ? bound + grow : bound - grow;
+    }
+    if (inside > 0) {
+        inside = (inside * scale->decay + 255) >> 8;
+        return upper ? bound - inside : bound + inside;
+    }
+    return bound;
+}
+
+void Render_AutoscaleUpdate(Render_Autoscale_t *scale, const HTPA_Stats_t *stats, int16_t *minTemp, int16_t *maxTemp) {
+    int32_t low = (int32_t)Render_HistLevel(stats, scale->ignore, false) << 8;
+    int32_t high = (int32_t)Render_HistLevel(stats, scale->ignore, true) << 8;
+
+    if (!scale->valid) {
+        scale->low = low;
+        scale->high = high;
+        scale->valid = true;
+    } else {
+        scale->low = Render_AutoscaleStep(scale, scale->low, low, false);
+        scale->high = Render_AutoscaleStep(scale, scale->high, high, true);
+    }
+
+    // narrow scenes are widened around their centre
+    int32_t lo = (scale->low + 128) >> 8, hi = (scale->high + 128) >> 8;
+    if (hi - lo < scale->minSpan) {
+        int32_t mid = (lo + hi) >> 1;
+        lo = mid - scale->minSpan / 2;
+        hi = lo + scale->minSpan;
+    }
+    *minTemp = lo;
+    *maxTemp = hi;
+}
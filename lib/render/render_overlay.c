@@ -0,0 +1,154 @@
+#include "render.h"
+#include "palette.h"
+#include <string.h>
+
+#define GLYPH_FIRST     ' '
+#define GLYPH_LAST      '_'
+
+// 5x7 glyphs of the characters we print, one byte per row with bit 4 the
+// leftmost pixel; lower case is drawn as upper case, anything else blank
+static const uint8_t Glyphs[GLYPH_LAST - GLYPH_FIRST + 1][7] = {
+    ['-' - GLYPH_FIRST] = { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 },
+    ['.' - GLYPH_FIRST] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C },
+    ['0' - GLYPH_FIRST] = { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E },
+    ['1' - GLYPH_FIRST] = { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E },
+    ['2' - GLYPH_FIRST] = { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F },
+    ['3' - GLYPH_FIRST] = { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E },
+    ['4' - GLYPH_FIRST] = { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 },
+    ['5' - GLYPH_FIRST] = { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E },
+    ['6' - GLYPH_FIRST] = { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E },
+    ['7' - GLYPH_FIRST] = { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },
+    ['8' - GLYPH_FIRST] = { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E },
+    ['9' - GLYPH_FIRST] = { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C },
+    [':' - GLYPH_FIRST] = { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 },
+    ['A' - GLYPH_FIRST] = { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 },
+    ['C' - GLYPH_FIRST] = { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E },
+    ['F' - GLYPH_FIRST] = { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 },
+    ['I' - GLYPH_FIRST] = { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },
+    ['M' - GLYPH_FIRST] = { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 },
+    ['N' - GLYPH_FIRST] = { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 },
+    ['P' - GLYPH_FIRST] = { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 },
+    ['S' - GLYPH_FIRST] = { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E },
+    ['T' - GLYPH_FIRST] = { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },
+    ['X' - GLYPH_FIRST] = { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 },
+};
+
+static const uint8_t *Render_Glyph(char c) {
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    if (c < GLYPH_FIRST || c > GLYPH_LAST) c = ' ';
+    return Glyphs[c - GLYPH_FIRST];
+}
+
+void Render_OverlayClear(Render_Overlay_t *overlay) {
+    overlay->count = 0;
+}
+
+void Render_OverlayRect(Render_Overlay_t *overlay, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    if (overlay->count >= RENDER_OVERLAY_MAX_ITEMS) return;
+
+    Render_OverlayItem_t *item = &overlay->item[overlay->count++];
+    item->text = false;
+    item->x = x;
+    item->y = y;
+    item->w = w;
+    item->h = h;
+    item->color = color;
+}
+
+void Render_OverlayText(Render_Overlay_t *overlay, int16_t x, int16_t y, const char *str, uint8_t scale, uint16_t color) {
+    if (overlay->count >= RENDER_OVERLAY_MAX_ITEMS) return;
+
+    Render_OverlayItem_t *item = &overlay->item[overlay->count++];
+    item->text = true;
+    item->scale = scale ? scale : 1;
+    item->x = x;
+    item->y = y;
+    strncpy(item->str, str, RENDER_OVERLAY_MAX_TEXT - 1);
+    item->str[RENDER_OVERLAY_MAX_TEXT - 1] = 0;
+    item->w = Render_TextWidth(item->str, item->scale);
+    item->h = RENDER_CHAR_HEIGHT * item->scale;
+    item->color = color;
+}
+
+bool Render_OverlayBounds(const Render_Overlay_t *overlay, int16_t *x, int16_t *y, uint16_t *w, uint16_t *h) {
+    if (!overlay->count) return false;
+
+    int16_t x0 = INT16_MAX, y0 = INT16_MAX, x1 = INT16_MIN, y1 = INT16_MIN;
+    for (uint8_t n = 0; n < overlay->count; n++) {
+        const Render_OverlayItem_t *item = &overlay->item[n];
+        if (item->x < x0) x0 = item->x;
+        if (item->y < y0) y0 = item->y;
+        if (item->x + item->w > x1) x1 = item->x + item->w;
+        if (item->y + item->h > y1) y1 = item->y + item->h;
+    }
+    *x = x0;
+    *y = y0;
+    *w = x1 - x0;
+    *h = y1 - y0;
+    return true;
+}
+
+uint16_t Render_TextWidth(const char *str, uint8_t scale) {
+    return strlen(str) * RENDER_CHAR_WIDTH * scale;
+}
+
+void Render_Fill(Render_Target_t *target, uint16_t color) {
+    color = RGB565_SWAP(color);
+    for (uint16_t y = 0; y < target->height; y++) {
+        uint16_t *row = Render_TargetRow(target, y);
+        for (uint16_t x = 0; x < target->width; x++) row[x] = color;
+    }
+}
+
+// Fills target pixels of the span [x0, x1) x [y0, y1) given in target coordinates
+static void Render_FillSpan(Render_Target_t *target, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > target->width) x1 = target->width;
+    if (y1 > target->height) y1 = target->height;
+
+    for (int16_t y = y0; y < y1; y++) {
+        uint16_t *row = Render_TargetRow(target, y);
+        for (int16_t x = x0; x < x1; x++) row[x] = color;
+    }
+}
+
+static void Render_CompositeText(const Render_OverlayItem_t *item, Render_Target_t *target, int16_t x, int16_t y, uint16_t color) {
+    uint8_t scale = item->scale;
+    int16_t left = item->x - x;
+    int16_t top = item->y - y;
+
+    for (const char *c = item->str; *c; c++, left += RENDER_CHAR_WIDTH * scale) {
+        if (left >= target->width) break;
+        if (left + RENDER_CHAR_WIDTH * scale <= 0) continue;
+
+        const uint8_t *glyph = Render_Glyph(*c);
+        for (uint8_t gy = 0; gy < 7; gy++) {
+            int16_t py = top + gy * scale;
+            if (py + scale <= 0 || py >= target->height || !glyph[gy]) continue;
+            for (uint8_t gx = 0; gx < 5; gx++) {
+                if (glyph[gy] & (0x10 >> gx)) {
+                    int16_t px = left + gx * scale;
+                    Render_FillSpan(target, px, py, px + scale, py + scale, color);
+                }
+            }
+        }
+    }
+}
+
+void Render_OverlayComposite(const Render_Overlay_t *overlay, Render_Target_t *target, int16_t x, int16_t y) {
+    for (uint8_t n = 0; n < overlay->count; n++) {
+        const Render_OverlayItem_t *item = &overlay->item[n];
+
+        // skip items outside the target
+        if (item->x >= x + target->width || item->x + item->w <= x) continue;
+        if (item->y >= y + target->height || item->y + item->h <= y) continue;
+
+        uint16_t color = RGB565_SWAP(item->color);
+        if (item->text) {
+            Render_CompositeText(item, target, x, y, color);
+        } else {
+            Render_FillSpan(target, item->x - x, item->y - y, item->x - x + item->w, item->y - y + item->h, color);
+        }
+    }
+}
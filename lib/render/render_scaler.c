@@ -0,0 +1,152 @@
+#include "render.h"
+#include <string.h>
+
+static int16_t Render_NearestWeight(int32_t t) {
+    return (t >= 0 && t < RENDER_WEIGHT_ONE) ? RENDER_WEIGHT_ONE : 0;
+}
+
+static int16_t Render_LinearWeight(int32_t t) {
+    if (t < 0) t = -t;
+    return (t < RENDER_WEIGHT_ONE) ? RENDER_WEIGHT_ONE - t : 0;
+}
+
+// Catmull-Rom, sharper than linear with a small overshoot at edges
+static int16_t Render_CubicWeight(int32_t t) {
+    float x = (t < 0 ? -t : t) / (float)RENDER_WEIGHT_ONE;
+    float w = 0;
+    if (x < 1) w = 1.5f * x * x * x - 2.5f * x * x + 1;
+    else if (x < 2) w = -0.5f * x * x * x + 2.5f * x * x - 4 * x + 2;
+    return (int16_t)(w * RENDER_WEIGHT_ONE + (w < 0 ? -0.5f : 0.5f));
+}
+
+const Render_Engine_t Render_Engines[RENDER_ENGINE_COUNT] = {
+    [RENDER_ENGINE_NEAREST]  = { "nearest",  1, 0, 0, Render_NearestWeight },
+    [RENDER_ENGINE_BILINEAR] = { "bilinear", 2, 0, 1, Render_LinearWeight },
+    [RENDER_ENGINE_BICUBIC]  = { "bicubic",  4, 1, 2, Render_CubicWeight },
+};
+
+// Taps of one axis, sampled at u = pos * cells / size. Cells past the edges
+// are clamped, the weights are corrected to sum up to exactly one.
+static void Render_BuildAxis(const Render_Engine_t *engine, uint16_t pos, uint16_t size, uint8_t cells, bool mirror, uint8_t *src, int16_t *weight) {
+    uint32_t u = (uint32_t)pos * cells;
+    int16_t cell = u / size;
+    int32_t frac = ((u % size) * RENDER_WEIGHT_ONE + size / 2) / size;
+    int16_t sum = 0;
+    uint8_t peak = 0;
+
+    for (uint8_t t = 0; t < engine->taps; t++) {
+        int16_t c = cell - engine->before + t;
+        if (c < 0) c = 0;
+        if (c >= cells) c = cells - 1;
+        src[t] = mirror ? cells - c - 1 : c;
+        weight[t] = engine->weight(frac - (t - engine->before) * RENDER_WEIGHT_ONE);
+        sum += weight[t];
+        if (weight[t] > weight[peak]) peak = t;
+    }
+    weight[peak] += RENDER_WEIGHT_ONE - sum;
+}
+
+int Render_LayoutInit(Render_Layout_t *layout, uint8_t engine, uint16_t width, uint16_t height, bool mirror) {
+    if (!layout || engine >= RENDER_ENGINE_COUNT) return HTPA_ERR;
+    if (width < HTPA_COLS || width > RENDER_MAX_WIDTH || height < HTPA_ROWS || height > RENDER_MAX_HEIGHT) return HTPA_ERR;
+
+    layout->engine = &Render_Engines[engine];
+    layout->width = width;
+    layout->height = height;
+    for (uint16_t x = 0; x < width; x++) {
+        Render_BuildAxis(layout->engine, x, width, HTPA_COLS, mirror, layout->colSrc[x], layout->colWeight[x]);
+    }
+    for (uint16_t y = 0; y < height; y++) {
+        Render_BuildAxis(layout->engine, y, height, HTPA_ROWS, false, layout->rowSrc[y], layout->rowWeight[y]);
+    }
+
+    // tile c starts at the first pixel with floor(pos * cells / size) == c
+    for (uint8_t c = 0; c <= HTPA_COLS; c++) {
+        layout->colStart[c] = ((uint32_t)c * width + HTPA_COLS - 1) / HTPA_COLS;
+    }
+    for (uint8_t r = 0; r <= HTPA_ROWS; r++) {
+        layout->rowStart[r] = ((uint32_t)r * height + HTPA_ROWS - 1) / HTPA_ROWS;
+    }
+    return HTPA_OK;
+}
+
+void Render_ScalerBegin(Render_Scaler_t *scaler, const Render_Layout_t *layout, const int16_t src[HTPA_ROWS][HTPA_COLS]) {
+    scaler->layout = layout;
+    scaler->src = src;
+    memset(scaler->lineRow, -1, sizeof(scaler->lineRow));
+}
+
+// Horizontal pass of one source row, loops specialised per tap count
+static void Render_ScalerLine(const Render_Layout_t *layout, const int16_t *s, int32_t *line) {
+    const uint8_t (*idx)[RENDER_MAX_TAPS] = layout->colSrc;
+    const int16_t (*w)[RENDER_MAX_TAPS] = layout->colWeight;
+
+    switch (layout->engine->taps) {
+        case 1:
+            for (uint16_t x = 0; x < layout->width; x++) {
+                line[x] = (int32_t)s[idx[x][0]] << RENDER_WEIGHT_BITS;
+            }
+            break;
+        case 2:
+            for (uint16_t x = 0; x < layout->width; x++) {
+                line[x] = s[idx[x][0]] * w[x][0] + s[idx[x][1]] * w[x][1];
+            }
+            break;
+        case 4:
+            for (uint16_t x = 0; x < layout->width; x++) {
+                line[x] = s[idx[x][0]] * w[x][0] + s[idx[x][1]] * w[x][1] +
+                          s[idx[x][2]] * w[x][2] + s[idx[x][3]] * w[x][3];
+            }
+            break;
+    }
+}
+
+// Returns the scratch line holding srcRow, filling one not needed by this output row
+static const int32_t *Render_ScalerGetLine(Render_Scaler_t *scaler, uint8_t srcRow, const uint8_t *needed, uint8_t taps) {
+    uint8_t n, t;
+
+    for (n = 0; n < RENDER_MAX_TAPS; n++) {
+        if (scaler->lineRow[n] == srcRow) return scaler->line[n];
+    }
+    for (n = 0; n < RENDER_MAX_TAPS; n++) {
+        for (t = 0; t < taps; t++) {
+            if (scaler->lineRow[n] == needed[t]) break;
+        }
+        if (t == taps) break;
+    }
+    Render_ScalerLine(scaler->layout, scaler->src[srcRow], scaler->line[n]);
+    scaler->lineRow[n] = srcRow;
+    return scaler->line[n];
+}
+
+void Render_ScalerRow(Render_Scaler_t *scaler, uint16_t row, uint16_t x, uint16_t count, int16_t *out) {
+    const Render_Layout_t *layout = scaler->layout;
+    const uint8_t *idx = layout->rowSrc[row];
+    const int16_t *w = layout->rowWeight[row];
+    uint8_t taps = layout->engine->taps;
+    const int32_t round = 1 << (2 * RENDER_WEIGHT_BITS - 1);
+    const int32_t *line[RENDER_MAX_TAPS];
+
+    for (uint8_t t = 0; t < taps; t++) {
+        line[t] = Render_ScalerGetLine(scaler, idx[t], idx, taps) + x;
+    }
+
+    switch (taps) {
+        case 1:
+            for (uint16_t col = 0; col < count; col++) {
+                out[col] = (line[0][col] + (round >> RENDER_WEIGHT_BITS)) >> RENDER_WEIGHT_BITS;
+            }
+            break;
+        case 2:
+            for (uint16_t col = 0; col < count; col++) {
+                out[col] = (line[0][col] * w[0] + line[1][col] * w[1] + round) >> (2 * RENDER_WEIGHT_BITS);
+            }
+            break;
+        case 4:
+            for (uint16_t col = 0; col < count; col++) {
+                out[col] = (line[0][col] * w[0] + line[1][col] * w[1] +
+                            line[2][col] * w[2] + line[3][col] * w[3] + round) >> (2 * RENDER_WEIGHT_BITS);
+            }
+            break;
+    }
+}
@@ -0,0 +1,44 @@
+#include "render.h"
+#include "freertos/task.h"
+
+static void Render_WorkerTask(void *pvParameters) {
+    Render_Worker_t *worker = (Render_Worker_t *)pvParameters;
+
+    while (1) {
+        xSemaphoreTake(worker->start, portMAX_DELAY);
+        worker->fn(worker->arg, worker->first, worker->count);
+        xSemaphoreGive(worker->done);
+    }
+}
+
+int Render_WorkerStart(Render_Worker_t *worker, const char *name, UBaseType_t priority, BaseType_t core) {
+    worker->task = NULL;
+    worker->fn = NULL;
+    worker->start = xSemaphoreCreateBinary();
+    worker->done = xSemaphoreCreateBinary();
+    if (!worker->start || !worker->done) return HTPA_ERR;
+
+    if (xTaskCreatePinnedToCore(Render_WorkerTask, name, 2048, worker, priority, &worker->task, core) != pdPASS) {
+        worker->task = NULL;
+        return HTPA_ERR;
+    }
+    return HTPA_OK;
+}
+
+void Render_WorkerRun(Render_Worker_t *worker, Render_JobFn fn, void *arg, uint16_t first, uint16_t count) {
+    if (!worker->task) {
+        fn(arg, first, count);
+        return;
+    }
+    worker->fn = fn;
+    worker->arg = arg;
+    worker->first = first;
+    worker->count = count;
+    xSemaphoreGive(worker->start);
+}
+
+void Render_WorkerJoin(Render_Worker_t *worker) {
+    if (worker->task) {
+        xSemaphoreTake(worker->done, portMAX_DELAY);
+    }
+}
@@ -1,30 +1,27 @@
 #include <TFT_eSPI.h>
 #include "driver/i2c.h"
-#include "freertos/semphr.h"
 
 #include "htpa.h"
 #include "palette.h"
+#include "render.h"
+#include <string.h>
 
 // TFT_eSPI display
 TFT_eSPI tft = TFT_eSPI();
-TFT_eSprite spr = TFT_eSprite(&tft);
-uint16_t* sprPtr;
+Render_Stream_t stream;
 
 // HTPA sensor data
 HTPA_Data_t htpa_data;
 HTPA_EEPROM_Data_t htpa_eeprom;
-SemaphoreHandle_t htpa_mutex;
-SemaphoreHandle_t data_ready_sem;
+TaskHandle_t displayTaskHandle;
 
-static tRGBcolor *pPalette;
-static uint16_t PaletteSteps = 0;
+static Render_Map_t colorMap;
 
 #define SW_VERSION_MAJOR	1
 #define SW_VERSION_MINOR	0
 
-#define CALC_MODE_DIRECT		0
-#define CALC_MODE_INTERPOL		1
-#define CALC_MODE				CALC_MODE_INTERPOL
+// Render engine at startup, switched at runtime by sending its number over serial
+#define RENDER_ENGINE_DEFAULT	RENDER_ENGINE_BILINEAR
 
 #define MIN_TEMP				-40
 #define MAX_TEMP				300
@@ -32,6 +29,16 @@ static uint16_t PaletteSteps = 0;
 #define SCALE_DEFAULT_MIN		10
 #define SCALE_DEFAULT_MAX		50
 #define AUTOSCALE_MODE
+#define AUTOSCALE_IGNORE		4		// coldest and hottest pixels left out of the range
+#define AUTOSCALE_ATTACK		96		// share of the distance per frame when the range grows, /256
+#define AUTOSCALE_DECAY			8		// and when it shrinks
+#define AUTOSCALE_HYSTERESIS	15		// deci Kelvin the scene moves inside the range before it shrinks
+
+// Histogram equalised AGC instead of the linear scale, toggled by sending 'h'
+#define AGC_DEFAULT				false
+#define AGC_PLATEAU				24		// pixels per 0.8 K histogram bin
+#define AGC_RATE				32		// share of the equalised curve taken per frame, /256
+#define AGC_THRESHOLD			3		// palette entries the curve drifts before it is applied
 
 #define dispWidth 				320
 #define dispHeight				240
@@ -39,152 +46,293 @@ static uint16_t PaletteSteps = 0;
 #define termWidth				32
 #define termHeight				32
 
-#define blockSize				7
-
-#if (CALC_MODE == CALC_MODE_DIRECT)
-    #define imageWidth				(blockSize * termWidth)
-    #define imageHeight 			(blockSize * termHeight)
-#endif
+// Image area left of the scale bar and above the status line, the frame is
+// scaled to the selected layout, switched at runtime by sending 'a', 'b', ...
+#define scaleHeight				224
+#define IMAGE_LAYOUT_DEFAULT	0
+
+static const uint16_t imageLayouts[][2] = {
+    { 224, 224 },		// 7x, the classic view
+    { 226, 226 },		// largest square
+    { 264, 198 },		// 4:3
+};
+#define IMAGE_LAYOUT_COUNT		(sizeof(imageLayouts) / sizeof(imageLayouts[0]))
+
+static uint16_t imageWidth = 0;
+static uint16_t imageHeight = 0;
+
+// Percentage of each band rendered by the worker on core 0
+#define WORKER_SHARE			50
+// Above the sensor task (2), whose end of conversion wait busy-polls below a
+// tick and would otherwise starve the worker while the display task joins it
+#define WORKER_PRIORITY			3
+
+static Render_Layout_t layout;
+static Render_Scaler_t scaler[2];
+static Render_Worker_t worker;
+static uint8_t renderEngine = RENDER_ENGINE_COUNT;
+static uint8_t imageLayout = IMAGE_LAYOUT_COUNT;
+static volatile uint8_t renderEngineRequest = RENDER_ENGINE_DEFAULT;
+static volatile uint8_t imageLayoutRequest = IMAGE_LAYOUT_DEFAULT;
+
+// Image is streamed to the display in bands of one tile row each
+#define maxBandHeight			((dispHeight + termHeight - 1) / termHeight)
+
+// Only tiles whose palette index changed are redrawn, all of them every
+// FULL_REFRESH_INTERVAL frames (0 to redraw every frame)
+#define FULL_REFRESH_INTERVAL	30
+
+static Render_Delta_t delta;
+
+static Render_Autoscale_t autoscale;
+static Render_Agc_t agc;
+static Render_Map_t agcMap;
+static volatile bool agcMode = AGC_DEFAULT;
+
+// Sensor side temporal noise filter, toggled by sending 'f'
+static bool filterMode = HTPA_FILTER_DEFAULT;
+
+// Crosshair and spot temperature, composited into the image bands
+static Render_Overlay_t overlay;
+
+// Status line and scale labels are rendered into a strip buffer and pushed
+// in one transfer each
+#define stripPixels				(240 * 8)
+static uint16_t *stripBuf;
+
+// pushImageDMA() waits for the previous transfer before starting this one
+static void PushBand(Render_Target_t *band, uint16_t x, uint16_t y, uint16_t rows, void *arg)
+{
+	tft.pushImageDMA(x, y, band->width, rows, band->buf);
+}
 
-#if (CALC_MODE == CALC_MODE_INTERPOL)
-    #define iSteps					blockSize
-    #define INT_MODE		
-    #define imageWidth 				(termWidth * iSteps)
-    #define	imageHeight 			(termHeight * iSteps)
-#endif
+static uint16_t UpdateDirtyTiles(const HTPA_Frame_t* frame, const Render_Map_t *map)
+{
+	static uint16_t sinceFull = 0;
+	bool full = ++sinceFull >= FULL_REFRESH_INTERVAL;
+	if (full)
+		sinceFull = 0;
+
+	uint16_t tiles = Render_DeltaUpdate(&delta, frame->pixelTemps, true, map, full);
+
+	// overlay tiles are redrawn every frame, including where it was last frame
+	static int16_t lastX, lastY;
+	static uint16_t lastW = 0, lastH = 0;
+	Render_DeltaMarkRect(&delta, &layout, lastX, lastY, lastW, lastH);
+	if (!Render_OverlayBounds(&overlay, &lastX, &lastY, &lastW, &lastH))
+		lastW = lastH = 0;
+	Render_DeltaMarkRect(&delta, &layout, lastX, lastY, lastW, lastH);
+	return tiles;
+}
 
+// Rows of one band, the display task and the render worker each fill a part
+// of it with their own scaler
+typedef struct {
+    Render_Scaler_t *scaler;
+    int16_t *line;
+    Render_Target_t *band;
+    uint16_t top;
+    uint16_t x;
+    const Render_Map_t *map;
+} BandJob_t;
+
+static void RenderBandRows(void *arg, uint16_t first, uint16_t count)
+{
+    BandJob_t *job = (BandJob_t*)arg;
 
+    for (uint16_t y = first; y < first + count; y++)
+    {
+        Render_ScalerRow(job->scaler, job->top + y, job->x, job->band->width, job->line);
+        Render_Colorize(job->line, Render_TargetRow(job->band, y), job->band->width, job->map);
+    }
+}
 
-#if (CALC_MODE == CALC_MODE_DIRECT)
-void DrawImage(HTPA_Data_t* htpa_data, tRGBcolor *pPalette, uint16_t PaletteSize, uint16_t X, uint16_t Y, uint8_t pixelWidth, uint8_t pixelHeight, float minTemp)
+// Rebuilds the scaling tables between frames, the worker is idle then
+static void SetRenderLayout(uint8_t engine, uint8_t image)
 {
-	spr[0].fillSprite(TFT_BLACK);
-	spr[1].fillSprite(TFT_BLACK);
-	for (int row = 0; row < termHeight; row++) {
-		for (int col = 0; col < termWidth; col++) {
-
-			int16_t colorIdx = (int16_t)(htpa_data->pixelTemps[row][termWidth - col - 1] * 10.0) - (minTemp * 10);
-
-			if (colorIdx < 0)
-				colorIdx = 0;
-			if (colorIdx >= PaletteSize)
-				colorIdx = PaletteSize - 1;
-
-	    	uint16_t color = tft.color565(pPalette[colorIdx].r, pPalette[colorIdx].g, pPalette[colorIdx].b);
-			uint8_t sel = row < (termHeight / 2) ? 0 : 1;
-			spr[sel].fillRect(col * pixelWidth + X, row * pixelHeight + Y, pixelWidth, pixelHeight, color);
-		}
-		if(row == (termHeight / 2 - 1)) tft.pushImageDMA(0, 0, imageWidth, imageHeight / 2, sprPtr[0]);
-		if(row == (termHeight - 1)) tft.pushImageDMA(0, imageHeight / 2, imageWidth, imageHeight / 2, sprPtr[1]);
-	}
+    if (Render_LayoutInit(&layout, engine, imageLayouts[image][0], imageLayouts[image][1], true))
+        return;
+
+    // a smaller image leaves the old one behind, the status strip
+    // may still be on its way to the display
+    if (image != imageLayout && imageWidth) {
+        tft.dmaWait();
+        tft.fillRect(0, 0, imageWidth, imageHeight, TFT_BLACK);
+    }
+
+    renderEngine = engine;
+    imageLayout = image;
+    imageWidth = layout.width;
+    imageHeight = layout.height;
+    Render_DeltaInit(&delta, layout.engine->before, layout.engine->after);
+    printf("Render engine: %s, %ux%u\r\n", layout.engine->name, imageWidth, imageHeight);
 }
-#endif
 
-#if (CALC_MODE == CALC_MODE_INTERPOL)
-void DrawHQImage(HTPA_Data_t* htpa_data, tRGBcolor *pPalette, uint16_t PaletteSize, uint16_t X, uint16_t Y, float minTemp)
+uint16_t DrawImage(const HTPA_Frame_t* frame, const Render_Map_t *map, uint16_t X, uint16_t Y)
 {
-    spr.fillSprite(TFT_BLACK);
-    
-    for (int row = 0; row < imageHeight; row++)
+    static int16_t line[2][RENDER_MAX_WIDTH];
+    BandJob_t job[2];
+
+    uint16_t tiles = UpdateDirtyTiles(frame, map);
+
+    for (int n = 0; n < 2; n++)
     {
-        int baseRow = row / iSteps;
-        int nextRow = (baseRow + 1) >= termHeight ? baseRow : baseRow + 1;
-        int stepY = row % iSteps;
-        
-        for (int col = 0; col < imageWidth; col++)
+        job[n].scaler = &scaler[n];
+        job[n].line = line[n];
+        job[n].map = map;
+        Render_ScalerBegin(&scaler[n], &layout, frame->pixelTemps);
+    }
+
+    // render band N+1 while band N is on its way to the display,
+    // each band is one row of tiles cut down to its dirty span
+    for (int tileRow = 0; tileRow < termHeight; tileRow++)
+    {
+        uint32_t dirty = delta.dirty[tileRow];
+        if (!dirty)
+            continue;
+        uint16_t x = layout.colStart[__builtin_ctz(dirty)];
+        uint16_t width = layout.colStart[32 - __builtin_clz(dirty)] - x;
+        uint16_t top = layout.rowStart[tileRow];
+        int rows = layout.rowStart[tileRow + 1] - top;
+
+        Render_Target_t *band = Render_StreamBand(&stream, width);
+        int split = rows - rows * WORKER_SHARE / 100;
+        for (int n = 0; n < 2; n++)
         {
-            int baseCol = col / iSteps;
-            int nextCol = (baseCol + 1) >= termWidth ? baseCol : baseCol + 1;
-            int stepX = col % iSteps;
-            
-            // Интерполяция температуры между четырьмя соседними точками
-            float temp1 = htpa_data->pixelTemps[baseRow][termWidth - baseCol - 1];
-            float temp2 = htpa_data->pixelTemps[baseRow][termWidth - nextCol - 1];
-            float temp3 = htpa_data->pixelTemps[nextRow][termWidth - baseCol - 1];
-            float temp4 = htpa_data->pixelTemps[nextRow][termWidth - nextCol - 1];
-            
-            // Билинейная интерполяция
-            float fx = (float)stepX / iSteps;
-            float fy = (float)stepY / iSteps;
-            
-            float temp = temp1 * (1 - fx) * (1 - fy) +
-                        temp2 * fx * (1 - fy) +
-                        temp3 * (1 - fx) * fy +
-                        temp4 * fx * fy;
-            
-            int16_t colorIdx = (int16_t)(temp * 10.0) - (minTemp * 10);
-            
-            if (colorIdx < 0)
-                colorIdx = 0;
-            if (colorIdx >= PaletteSize)
-                colorIdx = PaletteSize - 1;
-                
-            uint16_t color = tft.color565(pPalette[colorIdx].r, pPalette[colorIdx].g, pPalette[colorIdx].b);
-            uint8_t sel = row < (imageHeight / 2) ? 0 : 1;
-            spr.drawPixel(col + X, row + Y, color);
+            job[n].band = band;
+            job[n].top = top;
+            job[n].x = x;
         }
+
+        // bottom rows go to the worker on the sensor core
+        Render_WorkerRun(&worker, RenderBandRows, &job[1], split, rows - split);
+        RenderBandRows(&job[0], 0, split);
+        Render_WorkerJoin(&worker);
+
+        band->height = rows;
+        Render_OverlayComposite(&overlay, band, x, top);
+        Render_StreamFlush(&stream, x + X, top + Y, rows);
     }
-    tft.pushImageDMA(0, 0, imageWidth, imageHeight, sprPtr);
+    // the status strip reuses the bus
+    tft.dmaWait();
+    return tiles;
 }
-#endif
 
 void DrawScale(uint16_t X, uint16_t Y, uint16_t Width, uint16_t Height)
 {
-	tRGBcolor *Buffer = getPalette(PALETTE_IRON, Height);
-	if (!Buffer)
+	const uint16_t *Palette = getPaletteTable(PALETTE_IRON, false);
+	if (!Palette)
 	    return;
 
     for (int i = 0; i < Height; i++)
 	{
-		uint16_t color = tft.color565(Buffer[i].r, Buffer[i].g, Buffer[i].b);
-		tft.fillRect(X, Y + Height - i - 1, Width, 1, color);
+		tft.fillRect(X, Y + Height - i - 1, Width, 1, Palette[i * PALETTE_SIZE / Height]);
 	}
+}
+
+// Renders overlay (in strip coordinates) over a background and pushes it
+static void PushStrip(const Render_Overlay_t *strip, uint16_t X, uint16_t Y, uint16_t Width, uint16_t Height, uint16_t background)
+{
+	Render_Target_t target = { stripBuf, Width, Height, Width };
+
+	if (!stripBuf || Width * Height > stripPixels)
+		return;
 
-    freePalette(Buffer);
+	// previous strip may still be in flight
+	tft.dmaWait();
+	Render_Fill(&target, background);
+	Render_OverlayComposite(strip, &target, 0, 0);
+	tft.pushImageDMA(X, Y, Width, Height, stripBuf);
 }
 
-void DrawCenterTempColor(uint16_t cX, uint16_t cY, float Temp, tRGBcolor *color)
+void DrawCenterTempColor(Render_Overlay_t *overlay, uint16_t cX, uint16_t cY, float Temp, uint16_t color)
 {
 	uint8_t offMin = 5;
 	uint8_t offMax = 10;
 	uint8_t offTwin = 1;
+	uint8_t len = offMax - offMin + 1;
 
-	tft.drawLine(cX - offTwin, cY - offMin, cX - offTwin, cY - offMax, tft.color565(color->r, color->g, color->b));
-	tft.drawLine(cX + offTwin, cY - offMin, cX + offTwin, cY - offMax, tft.color565(color->r, color->g, color->b));
+	Render_OverlayRect(overlay, cX - offTwin, cY - offMax, 1, len, color);
+	Render_OverlayRect(overlay, cX + offTwin, cY - offMax, 1, len, color);
 
-	tft.drawLine(cX - offTwin, cY + offMin, cX - offTwin, cY + offMax, tft.color565(color->r, color->g, color->b));
-	tft.drawLine(cX + offTwin, cY + offMin, cX + offTwin, cY + offMax, tft.color565(color->r, color->g, color->b));
+	Render_OverlayRect(overlay, cX - offTwin, cY + offMin, 1, len, color);
+	Render_OverlayRect(overlay, cX + offTwin, cY + offMin, 1, len, color);
 
-	tft.drawLine(cX - offMin, cY - offTwin, cX - offMax, cY - offTwin, tft.color565(color->r, color->g, color->b));
-	tft.drawLine(cX - offMin, cY + offTwin, cX - offMax, cY + offTwin, tft.color565(color->r, color->g, color->b));
+	Render_OverlayRect(overlay, cX - offMax, cY - offTwin, len, 1, color);
+	Render_OverlayRect(overlay, cX - offMax, cY + offTwin, len, 1, color);
 
-	tft.drawLine(cX + offMin, cY - offTwin, cX + offMax, cY - offTwin, tft.color565(color->r, color->g, color->b));
-	tft.drawLine(cX + offMin, cY + offTwin, cX + offMax, cY + offTwin, tft.color565(color->r, color->g, color->b));
+	Render_OverlayRect(overlay, cX + offMin, cY - offTwin, len, 1, color);
+	Render_OverlayRect(overlay, cX + offMin, cY + offTwin, len, 1, color);
 
 	if ((Temp > -100) && (Temp < 500)) {
         char str[16] = {0};
 		sprintf(str, "%.1f", Temp);
-        tft.setTextColor(tft.color565(color->r, color->g, color->b));
-        tft.drawString(str, cX + 8, cY + 8, 2);
+        Render_OverlayText(overlay, cX + 8, cY + 8, str, 2, color);
     }
 }
 
-void DrawCenterTemp(uint16_t X, uint16_t Y, uint16_t Width, uint16_t Height, float Temp)
+void DrawCenterTemp(Render_Overlay_t *overlay, uint16_t X, uint16_t Y, uint16_t Width, uint16_t Height, float Temp)
 {
 	uint16_t cX = (Width >> 1) + X;
 	uint16_t cY = (Height >> 1) + Y;
-	tRGBcolor colorTFT_BLACK = {0, 0, 0};
-	tRGBcolor colorTFT_WHITE = {255, 255, 255};
+	DrawCenterTempColor(overlay, cX + 1, cY + 1, Temp, TFT_BLACK);
+	DrawCenterTempColor(overlay, cX, cY, Temp, TFT_WHITE);
+}
 
-	DrawCenterTempColor(cX + 1, cY + 1, Temp, &colorTFT_BLACK);
-	DrawCenterTempColor(cX, cY, Temp, &colorTFT_WHITE);
+void DrawScaleLabels(uint16_t X, uint16_t Width, float minTemp, float maxTemp)
+{
+	Render_Overlay_t label;
+	char str[16] = {0};
+	uint16_t Height = RENDER_CHAR_HEIGHT * 2;
+
+	Render_OverlayClear(&label);
+	sprintf(str, "%2.0f", maxTemp);
+	Render_OverlayText(&label, (Width - Render_TextWidth(str, 2)) / 2, 1, str, 2, TFT_BLACK);
+	PushStrip(&label, X, 2, Width, Height, TFT_WHITE);
+
+	Render_OverlayClear(&label);
+	sprintf(str, "%2.0f", minTemp);
+	Render_OverlayText(&label, (Width - Render_TextWidth(str, 2)) / 2, 1, str, 2, TFT_WHITE);
+	PushStrip(&label, X, scaleHeight - Height, Width, Height, TFT_BLACK);
+}
+
+void DrawStatus(uint16_t Y, float minT, float maxT, float FPS, uint32_t tiles)
+{
+	Render_Overlay_t status;
+	char str[16] = {0};
+
+	Render_OverlayClear(&status);
+	snprintf(str, sizeof(str), "MIN: %2.1f", minT);
+	Render_OverlayText(&status, 1, 0, str, 1, RGB565(32, 32, 192));
+
+	snprintf(str, sizeof(str), "MAX: %2.1f", maxT);
+	Render_OverlayText(&status, 69, 0, str, 1, RGB565(192, 32, 32));
+
+	snprintf(str, sizeof(str), "FPS: %2.1f", FPS);
+	Render_OverlayText(&status, 138, 0, str, 1, TFT_GREEN);
+
+	// changed tiles per frame
+	snprintf(str, sizeof(str), "T:%4u", (unsigned)tiles);
+	Render_OverlayText(&status, 198, 0, str, 1, TFT_WHITE);
+
+	PushStrip(&status, 0, Y, 240, RENDER_CHAR_HEIGHT, TFT_BLACK);
+}
+
+// the status line is full, sensor latency goes to the serial port
+void ReportTiming(const HTPA_Timing_t *timing)
+{
+	printf("Frame %luus: conv %luus, wait %luus (sleep %luus, %lu polls), transfer %luus, calc %luus, oversampled %u\r\n",
+		(unsigned long)timing->frame_us, (unsigned long)timing->conv_time_us,
+		(unsigned long)timing->wait_us, (unsigned long)timing->sleep_us,
+		(unsigned long)timing->status_polls, (unsigned long)timing->transfer_us,
+		(unsigned long)timing->calc_us, (unsigned)timing->oversampled);
 }
 
 void DrawBattery(uint16_t X, uint16_t Y, float capacity)
 {
 	uint16_t Color = TFT_GREEN;
 	if (capacity < 80)
-		Color = tft.color565(249, 166, 2);
+		Color = RGB565(249, 166, 2);
 	if (capacity < 50)
 		Color = TFT_RED;
 
@@ -202,7 +350,7 @@ void DrawBattery(uint16_t X, uint16_t Y, float capacity)
 void htpaSensorTask(void *pvParameters) {
     while(1) {
         if (HTPA_CaptureData(&htpa_data, &htpa_eeprom) == HTPA_OK) {
-            xSemaphoreGive(data_ready_sem);
+            xTaskNotifyGive(displayTaskHandle);
         } else {
             printf("Failed Capture Data!\r\n");
             vTaskDelay(pdMS_TO_TICKS(100));
@@ -213,150 +361,152 @@ void htpaSensorTask(void *pvParameters) {
 // Task for display and interpolation (Core 1)
 void displayTask(void *pvParameters) {
     uint32_t frameCount = 0;
+    uint32_t tileCount = 0;
     uint32_t lastFPSCheck = 0;
     float minTemp = 0;
     float maxTemp = 0;
     float minTempNew = SCALE_DEFAULT_MIN;
     float maxTempNew = SCALE_DEFAULT_MAX;
 
-	DrawScale(dispWidth - 52, 0, 50, imageHeight);
+	DrawScale(dispWidth - 52, 0, 50, scaleHeight);
+    Render_AgcInit(&agc, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, AGC_PLATEAU, AGC_RATE, AGC_THRESHOLD);
+    Render_AutoscaleInit(&autoscale, AUTOSCALE_IGNORE, AUTOSCALE_ATTACK, AUTOSCALE_DECAY, AUTOSCALE_HYSTERESIS, MIN_TEMPSCALE_DELTA * 10);
 
     while(1) {
-        if(xSemaphoreTake(data_ready_sem, pdMS_TO_TICKS(100)) == pdTRUE) {
-			xSemaphoreTake(htpa_mutex, portMAX_DELAY);
-            #if (CALC_MODE == CALC_MODE_DIRECT)
-                if (pPalette)
-                    DrawImage(&htpa_data, pPalette, PaletteSteps, 0, 0, blockSize, blockSize, minTemp);
-            #endif
+        const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+        if (frame) {
+            // gathered by the sensor task while calculating the frame
+            float minT = HTPA_DK_TO_C(frame->stats.minTemp);
+            float maxT = HTPA_DK_TO_C(frame->stats.maxTemp);
+            double MainTemp = HTPA_DK_TO_C(frame->stats.centerTemp);
 
-            #if (CALC_MODE == CALC_MODE_INTERPOL)
-                if (pPalette)
-                    DrawHQImage(&htpa_data, pPalette, PaletteSteps, 0, 0, minTemp);
-            #endif
+            maxT = min(maxT, (float)MAX_TEMP);
+            minT = max(minT, (float)MIN_TEMP);
 
-            float minT = 300;
-            float maxT = -40;
-            
-            for (uint8_t i = 0; i < termHeight; i++) {
-                for(uint8_t j = 0; j < termWidth; j++) {
-                    float pix_temp = (float)htpa_data.pixelTemps[i][j];
-                    maxT = max(maxT, pix_temp);
-                    minT = min(minT, pix_temp);
-                }
-            }
+            // the overlay is placed on the new image size
+            if (renderEngineRequest != renderEngine || imageLayoutRequest != imageLayout)
+                SetRenderLayout(renderEngineRequest, imageLayoutRequest);
 
-            double MainTemp =
-                htpa_data.pixelTemps[(termHeight >> 1) - 1][(termWidth >> 1) - 1] +
-                htpa_data.pixelTemps[(termHeight >> 1) - 1][(termWidth >> 1)] +
-                htpa_data.pixelTemps[(termHeight >> 1)][(termWidth >> 1) - 1] +
-                htpa_data.pixelTemps[(termHeight >> 1)][(termWidth >> 1)];
-            MainTemp /= 4;
-            xSemaphoreGive(htpa_mutex);
+            Render_OverlayClear(&overlay);
+            DrawCenterTemp(&overlay, 0, 0, imageWidth, imageHeight, MainTemp);
 
-            maxT = min(maxT, (float)MAX_TEMP);
-            minT = max(minT, (float)MIN_TEMP);
+            // the scale follows whole degrees, so the palette and the labels
+            // only change together when a label does
+            #ifdef AUTOSCALE_MODE
+                int16_t scaleMin, scaleMax;
+                Render_AutoscaleUpdate(&autoscale, &frame->stats, &scaleMin, &scaleMax);
+                minTempNew = max(roundf(HTPA_DK_TO_C(scaleMin)), (float)MIN_TEMP);
+                maxTempNew = min(roundf(HTPA_DK_TO_C(scaleMax)), (float)MAX_TEMP);
+            #endif
+            // equalised palette spans the scene, so do the labels
+            if (agcMode) {
+                minTempNew = roundf(minT);
+                maxTempNew = roundf(maxT);
+            }
 
-            DrawCenterTemp(0, 0, imageWidth, imageHeight, MainTemp);
-			
 			if ((minTempNew != minTemp) || (maxTempNew != maxTemp)) {
-					float Delta = maxTempNew - minTempNew;
-					if (Delta < MIN_TEMPSCALE_DELTA) {
-						minTempNew -= (MIN_TEMPSCALE_DELTA - Delta) / 2;
-						maxTempNew += (MIN_TEMPSCALE_DELTA - Delta) / 2;
-					}
-
 					minTemp = minTempNew;
 					maxTemp = maxTempNew;
 
-					freePalette(pPalette);
-					PaletteSteps = (uint16_t)((maxTemp - minTemp) * 10);
-					pPalette = getPalette(PALETTE_IRON, PaletteSteps);
-					char str[16] = {0};
-					int16_t TextWidth = 0;
-
-					sprintf(str, "%2.0f", maxTemp);
-					TextWidth = tft.textWidth(str, 2);
-					tft.setTextColor(TFT_BLACK, TFT_WHITE);
-					tft.fillRect(dispWidth - 52 + (50 - TextWidth) / 2, 2, 50, tft.fontHeight(2), TFT_WHITE);
-					tft.drawString(str, dispWidth - 52 + (50 - TextWidth) / 2, 2, 2);
-
-					sprintf(str, "%2.0f", minTemp);
-					TextWidth = tft.textWidth(str, 2);
-					tft.fillRect(dispWidth - 52 + (50 - TextWidth) / 2, imageHeight - tft.fontHeight(2), 50, tft.fontHeight(2), TFT_BLACK);
-					tft.setTextColor(TFT_WHITE, TFT_BLACK);
-					tft.drawString(str, dispWidth - 52 + (50 - TextWidth) / 2, imageHeight - tft.fontHeight(2), 2);
+					Render_MapInit(&colorMap, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, HTPA_C_TO_DK(minTemp), HTPA_C_TO_DK(maxTemp));
+					DrawScaleLabels(dispWidth - 52, 50, minTemp, maxTemp);
 				}
 
+            const Render_Map_t *map = &colorMap;
+            if (agcMode) {
+                Render_AgcUpdate(&agc, &frame->stats, &agcMap);
+                map = &agcMap;
+            }
+            if (map->palette)
+                tileCount += DrawImage(frame, map, 0, 0);
+
             frameCount++;
             uint32_t currentMillis = millis();
             if (currentMillis - lastFPSCheck >= 1000) {
                 float current_FPS = frameCount * 1000.0f / (currentMillis - lastFPSCheck);
+                uint32_t tiles = tileCount / frameCount;
                 frameCount = 0;
+                tileCount = 0;
                 lastFPSCheck = currentMillis;
 
-                tft.setTextColor(tft.color565(32, 32, 192), TFT_BLACK);
-                tft.setCursor(1, 228);
-                tft.printf("MIN: %2.1f ", minT);
-
-                tft.setTextColor(tft.color565(192, 32, 32), TFT_BLACK);
-                tft.setCursor(69, 228);
-                tft.printf("MAX: %2.1f ", maxT);
-
-                tft.setTextColor(TFT_GREEN, TFT_BLACK);
-                tft.setCursor(138, 228);
-                tft.printf("FPS: %2.1f", current_FPS);
+                DrawStatus(228, minT, maxT, current_FPS, tiles);
+                ReportTiming(&frame->timing);
             }
-
-            #ifdef AUTOSCALE_MODE
-                minTempNew = minT;
-                maxTempNew = maxT;
-            #endif
+        } else {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
         }
     }
 }
 
 //==============================================================================
 void setup() {
-    htpa_mutex = xSemaphoreCreateMutex();
-    data_ready_sem = xSemaphoreCreateBinary();
-
+    Serial.begin(115200);
     tft.init();
     tft.initDMA();
     tft.setRotation(3);
     tft.fillScreen(TFT_BLACK);
     tft.setTextSize(1);
 
-    sprPtr = (uint16_t*)spr.createSprite(imageWidth, imageHeight);
-    spr.setViewport(0, 0, imageWidth, imageHeight);
-    spr.setTextDatum(MC_DATUM);
+    // band buffers hold display byte order, pushed as they are
+    uint16_t *bandBuf0 = (uint16_t*)heap_caps_malloc(RENDER_MAX_WIDTH * maxBandHeight * sizeof(uint16_t), MALLOC_CAP_DMA);
+    uint16_t *bandBuf1 = (uint16_t*)heap_caps_malloc(RENDER_MAX_WIDTH * maxBandHeight * sizeof(uint16_t), MALLOC_CAP_DMA);
+    if (Render_StreamInit(&stream, bandBuf0, bandBuf1, RENDER_MAX_WIDTH, maxBandHeight, PushBand, NULL)) {
+        printf("Failed allocate render bands!\r\n");
+        return;
+    }
+    stripBuf = (uint16_t*)heap_caps_malloc(stripPixels * sizeof(uint16_t), MALLOC_CAP_DMA);
     tft.startWrite();
 
+    // preempts the sensor task for one half band at a time, the sensor keeps
+    // its latched block until then
+    if (Render_WorkerStart(&worker, "Render_Worker", WORKER_PRIORITY, 0))
+        printf("Render worker not started, rendering on one core\r\n");
+
     if (HTPA_Init(&htpa_data, &htpa_eeprom, I2C_NUM_0, GPIO_NUM_16, GPIO_NUM_4)) {
         printf("Failed init HTPA sensor!\r\n");
         return;
     }
 
     xTaskCreatePinnedToCore(
-        htpaSensorTask,
-        "HTPA_Task",
-        4096,
+        displayTask,
+        "Display_Task",
+        8192,
         NULL,
         1,
-        NULL,
-        0  // Core 0
+        &displayTaskHandle,
+        1  // Core 1
     );
 
     xTaskCreatePinnedToCore(
-        displayTask,
-        "Display_Task",
-        8192,
+        htpaSensorTask,
+        "HTPA_Task",
+        4096,
         NULL,
-        1,
+        2,
         NULL,
-        1  // Core 1
+        0  // Core 0
     );
 }
 
 void loop() {
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    while (Serial.available()) {
+        int c = Serial.read();
+        if (c >= '0' && c < '0' + RENDER_ENGINE_COUNT)
+            renderEngineRequest = c - '0';
+        if (c >= 'a' && c < 'a' + (int)IMAGE_LAYOUT_COUNT)
+            imageLayoutRequest = c - 'a';
+        if (c == 'h')
+            agcMode = !agcMode;
+        if (c == 'f') {
+            filterMode = !filterMode;
+            HTPA_SetFilter(filterMode);
+        }
+        // 1, 2, 4 ... raw frames averaged per displayed frame
+        if (c == 'o') {
+            uint8_t frames = HTPA_GetOversampling() * 2;
+            HTPA_SetOversampling(frames > HTPA_OVERSAMPLE_MAX ? 1 : frames);
+            printf("Oversampling: %u\r\n", HTPA_GetOversampling());
+        }
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
 }
\ No newline at end of file
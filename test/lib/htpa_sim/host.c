@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include "htpa_sim.h"
+#include "esp32-hal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+// Arduino and FreeRTOS on the host, all on the virtual clock of the simulator.
+// Tasks are real threads, so jobs handed to a task run concurrently.
+
+uint32_t sim_allocs;
+
+unsigned long millis(void) {
+    return sim_us / 1000;
+}
+
+unsigned long micros(void) {
+    return sim_us;
+}
+
+void delay(uint32_t ms) {
+    sim_us += ms * 1000ULL;
+}
+
+void delayMicroseconds(uint32_t us) {
+    sim_us += us;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    sim_us += ticks * portTICK_PERIOD_MS * 1000ULL;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return sim_us / 1000 / portTICK_PERIOD_MS;
+}
+
+typedef struct {
+    pthread_t thread;
+    TaskFunction_t fn;
+    void *arg;
+} Host_Task_t;
+
+static void *Host_TaskMain(void *arg) {
+    Host_Task_t *task = (Host_Task_t *)arg;
+    task->fn(task->arg);
+    return NULL;
+}
+
+// A detached thread, priority and core are ignored
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *task, BaseType_t core) {
+    Host_Task_t *t = (Host_Task_t *)malloc(sizeof(Host_Task_t));
+    if (!t) return pdFAIL;
+    t->fn = fn;
+    t->arg = arg;
+    if (pthread_create(&t->thread, NULL, Host_TaskMain, t)) {
+        free(t);
+        return pdFAIL;
+    }
+    pthread_detach(t->thread);
+    if (task) *task = t;
+    return pdPASS;
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    sim_allocs++;
+    return malloc(size);
+}
+
+void heap_caps_free(void *ptr) {
+    free(ptr);
+}
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool given;
+} Host_Semaphore_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    Host_Semaphore_t *sem = (Host_Semaphore_t *)malloc(sizeof(Host_Semaphore_t));
+    if (!sem) return NULL;
+    pthread_mutex_init(&sem->lock, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    sem->given = false;
+    return sem;
+}
+
+// Real time does not map to the virtual clock: a timeout of 0 only tries,
+// any other waits until the semaphore is given
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) {
+    Host_Semaphore_t *sem = (Host_Semaphore_t *)handle;
+    BaseType_t taken = pdFALSE;
+
+    pthread_mutex_lock(&sem->lock);
+    while (!sem->given && ticks) pthread_cond_wait(&sem->cond, &sem->lock);
+    if (sem->given) {
+        sem->given = false;
+        taken = pdTRUE;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+    Host_Semaphore_t *sem = (Host_Semaphore_t *)handle;
+    BaseType_t given;
+
+    pthread_mutex_lock(&sem->lock);
+    given = sem->given ? pdFALSE : pdTRUE;
+    sem->given = true;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->lock);
+    return given;
+}
@@ -0,0 +1,218 @@
+#include "htpa_sim.h"
+#include <string.h>
+
+int sim_ptat;
+int sim_vdd;
+int sim_eo;
+int sim_signal;
+int sim_noise;
+uint32_t sim_conv_us;
+int sim_nack_reg;
+
+uint64_t sim_us;
+uint32_t sim_conversions;
+uint32_t sim_blind_conversions;
+uint32_t sim_status_polls;
+uint32_t sim_reads;
+uint32_t sim_writes;
+uint32_t sim_batches;
+uint32_t sim_overlapped;
+uint32_t sim_early_reads;
+
+#define SIM_BUS_US_PER_BYTE 10
+
+static uint8_t eeprom_img[0x2000];
+static uint8_t sim_config;
+static bool conv_active;
+static uint64_t conv_done_at;
+static uint8_t latched_top[258], latched_bot[258];
+static uint8_t unread;              // halves of the latched block not read yet
+static uint32_t rng;
+static bool batching;
+
+static int Sim_Random(int n) {
+    rng = rng * 1103515245 + 12345;
+    return (rng >> 16) % n;
+}
+
+static void Sim_Put16(uint8_t *buf, int value) {
+    buf[0] = value >> 8;
+    buf[1] = value;
+}
+
+// End of conversion: the block selected by the config register is latched
+// into the read registers, PTAT or VDD in front of the pixels
+static void Sim_Latch(void) {
+    int block = (sim_config >> 4) & 3;
+    bool blind = sim_config & CONFIG_BLIND;
+    int first = (sim_config & CONFIG_VDD_MEAS) ? sim_vdd : sim_ptat;
+
+    Sim_Put16(latched_top, first);
+    Sim_Put16(latched_bot, first);
+    for (int k = 0; k < 128; k++) {
+        int top, bot;
+        if (blind) {
+            top = sim_eo + k;
+            bot = sim_eo + 200 + k;
+        } else {
+            top = sim_eo + 3000 + sim_signal + ((block * 128 + k) % 97) * 10;
+            bot = sim_eo + 3000 + sim_signal + ((block * 131 + k) % 89) * 12;
+        }
+        if (sim_noise) {
+            top += Sim_Random(sim_noise) - sim_noise / 2;
+            bot += Sim_Random(sim_noise) - sim_noise / 2;
+        }
+        Sim_Put16(&latched_top[2 + 2 * k], top);
+        Sim_Put16(&latched_bot[2 + 2 * k], bot);
+    }
+    unread = 3;
+    conv_active = false;
+}
+
+static void Sim_Advance(uint32_t us) {
+    sim_us += us;
+    if (conv_active && sim_us >= conv_done_at) Sim_Latch();
+}
+
+int HTPA_I2C_Init(int i2c_num, int sda_pin, int scl_pin, uint32_t clk_speed) {
+    return 0;
+}
+
+int HTPA_I2C_DeInit(int i2c_num) {
+    return 0;
+}
+
+// A single transaction is a command link of its own
+static int Sim_Nack(uint8_t reg) {
+    if (!batching) sim_batches++;
+    if (sim_nack_reg != reg) return 0;
+    sim_nack_reg = -1;
+    return -1;
+}
+
+int HTPA_I2C_Write(uint8_t reg, uint8_t *data, uint16_t len) {
+    sim_writes++;
+    Sim_Advance((3 + len) * SIM_BUS_US_PER_BYTE);
+    if (Sim_Nack(reg)) return -1;
+    if (reg == HTPA_CONFIG_REG) {
+        sim_config = data[0];
+        if (sim_config & CONFIG_START) {
+            conv_active = true;
+            conv_done_at = sim_us + sim_conv_us;
+            sim_conversions++;
+            if (unread) sim_overlapped++;
+            if (sim_config & CONFIG_BLIND) sim_blind_conversions++;
+        }
+    }
+    return 0;
+}
+
+int HTPA_I2C_Read(uint8_t reg, uint8_t *data, uint16_t len) {
+    sim_reads++;
+    Sim_Advance((4 + len) * SIM_BUS_US_PER_BYTE);
+    if (Sim_Nack(reg)) return -1;
+    if (reg == HTPA_STATUS_REG) {
+        sim_status_polls++;
+        data[0] = conv_active ? 0 : STATUS_EOC;
+    } else if (reg == HTPA_READ_TOP) {
+        memcpy(data, latched_top, len);
+        if (!(unread & 1)) sim_early_reads++;
+        unread &= ~1;
+    } else if (reg == HTPA_READ_BOTTOM) {
+        memcpy(data, latched_bot, len);
+        if (!(unread & 2)) sim_early_reads++;
+        unread &= ~2;
+    }
+    return 0;
+}
+
+int HTPA_I2C_Transfer(const HTPA_I2C_Xfer_t *xfer, uint8_t count) {
+    int ret = 0;
+    sim_batches++;
+    batching = true;
+    for (uint8_t i = 0; i < count && !ret; i++) {
+        ret = xfer[i].read ? HTPA_I2C_Read(xfer[i].reg, xfer[i].data, xfer[i].len)
+                           : HTPA_I2C_Write(xfer[i].reg, xfer[i].data, xfer[i].len);
+        Sim_Advance(xfer[i].settle_us);
+    }
+    batching = false;
+    return ret;
+}
+
+int HTPA_EEPROM_Read(uint16_t addr, uint8_t *data, uint16_t len) {
+    memcpy(data, eeprom_img + addr, len);
+    return 0;
+}
+
+static void Sim_Write8(uint16_t addr, uint8_t value) {
+    eeprom_img[addr] = value;
+}
+
+static void Sim_Write16(uint16_t addr, uint16_t value) {
+    memcpy(eeprom_img + addr, &value, 2);
+}
+
+static void Sim_WriteFloat(uint16_t addr, float value) {
+    memcpy(eeprom_img + addr, &value, 4);
+}
+
+void HTPA_SimReset(uint16_t TN) {
+    sim_ptat = 38000;
+    sim_vdd = 31000;
+    sim_eo = 34000;
+    sim_signal = -3000;
+    sim_noise = 0;
+    sim_conv_us = 25000;
+    sim_nack_reg = -1;
+
+    sim_us = 0;
+    sim_conversions = 0;
+    sim_blind_conversions = 0;
+    sim_status_polls = 0;
+    sim_reads = 0;
+    sim_writes = 0;
+    sim_batches = 0;
+    sim_overlapped = 0;
+    sim_early_reads = 0;
+    sim_allocs = 0;
+    sim_config = 0;
+    conv_active = false;
+    unread = 0;
+    rng = 1;
+
+    memset(eeprom_img, 0, sizeof(eeprom_img));
+    Sim_WriteFloat(EEPROM_PIXC_MIN, 1.0e8f);
+    Sim_WriteFloat(EEPROM_PIXC_MAX, 2.0e8f);
+    Sim_Write8(EEPROM_GRADSCALE, 20);
+    Sim_Write16(EEPROM_TN, TN);
+    Sim_Write8(EEPROM_EPSILON, 100);
+    Sim_Write8(EEPROM_MBIT_CALIB, 0x2C);
+    Sim_Write8(EEPROM_BIAS_CALIB, 5);
+    Sim_Write8(EEPROM_CLK_CALIB, 0x15);
+    Sim_Write8(EEPROM_BPA_CALIB, 0x0C);
+    Sim_Write8(EEPROM_PU_CALIB, 0x88);
+    Sim_Write16(EEPROM_VDDTH1, 30000);
+    Sim_Write16(EEPROM_VDDTH2, 32000);
+    Sim_WriteFloat(EEPROM_PTAT_GRAD, 0.0171f);
+    Sim_WriteFloat(EEPROM_PTAT_OFFSET, 2195.0f);
+    Sim_Write16(EEPROM_PTAT_TH1, 36000);
+    Sim_Write16(EEPROM_PTAT_TH2, 40000);
+    Sim_Write8(EEPROM_VDDSCGRAD, 16);
+    Sim_Write8(EEPROM_VDDSCOFF, 20);
+    Sim_Write8(EEPROM_GLOBALOFF, 3);
+    Sim_Write16(EEPROM_GLOBALGAIN, 10000);
+    Sim_Write8(EEPROM_NROFDEFPIX, 2);
+    Sim_Write16(EEPROM_DEADPIXADDR, HTPA_SIM_DEAD_0);
+    Sim_Write16(EEPROM_DEADPIXADDR + 2, HTPA_SIM_DEAD_1);
+    Sim_Write8(EEPROM_DEADPIXMASK, 0x55);
+    Sim_Write8(EEPROM_DEADPIXMASK + 1, 0x55);
+    for (int i = 0; i < HTPA_BLOCKS * 2 * HTPA_COLS; i++) {
+        Sim_Write16(EEPROM_VDDCOMPGRAD + 2 * i, (int16_t)(Sim_Random(2000) - 1000));
+        Sim_Write16(EEPROM_VDDCOMPOFF + 2 * i, (int16_t)(Sim_Random(2000) - 1000));
+    }
+    for (int i = 0; i < HTPA_PIXELS; i++) {
+        Sim_Write16(EEPROM_THGRAD + 2 * i, (int16_t)(Sim_Random(2000) - 1000));
+        Sim_Write16(EEPROM_THOFFSET + 2 * i, (int16_t)(Sim_Random(400) - 200));
+        Sim_Write16(EEPROM_P + 2 * i, Sim_Random(65535));
+    }
+}
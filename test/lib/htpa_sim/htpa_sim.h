@@ -0,0 +1,47 @@
+#ifndef _HTPA_SIM_H_
+#define _HTPA_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "htpa.h"
+
+// Host simulation of a HTPA32x32d behind the HTPA_I2C_* hooks, together with
+// the Arduino and FreeRTOS calls the libraries use. Time is virtual and only
+// advances with bus traffic, delays and conversions, so runs are repeatable.
+
+// Scene and sensor, may be changed between frames
+extern int sim_ptat;                // PTAT reading
+extern int sim_vdd;                 // VDD reading
+extern int sim_eo;                  // blind pixel level
+extern int sim_signal;              // added to every active pixel
+extern int sim_noise;               // peak to peak uniform noise on every pixel
+extern uint32_t sim_conv_us;        // conversion time per block
+extern int sim_nack_reg;            // next transaction on this register is not acknowledged, -1 for none
+
+// Virtual clock and counters, cleared by HTPA_SimReset
+extern uint64_t sim_us;
+extern uint32_t sim_conversions;
+extern uint32_t sim_blind_conversions;
+extern uint32_t sim_status_polls;
+extern uint32_t sim_reads;
+extern uint32_t sim_writes;
+extern uint32_t sim_batches;        // command links, a HTPA_I2C_Transfer batch or a single transaction
+extern uint32_t sim_overlapped;     // conversions started before the last block was read out
+extern uint32_t sim_early_reads;    // block halves read again before the next end of conversion
+extern uint32_t sim_allocs;         // heap_caps_malloc calls
+
+// Restores the default scene and writes an EEPROM image for table number TN
+// with two defective pixels, HTPA_SIM_DEAD_0 and HTPA_SIM_DEAD_1
+#define HTPA_SIM_DEAD_0     100
+#define HTPA_SIM_DEAD_1     700
+void HTPA_SimReset(uint16_t TN);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
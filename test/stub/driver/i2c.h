@@ -0,0 +1,16 @@
+#ifndef _DRIVER_I2C_H_
+#define _DRIVER_I2C_H_
+
+// Host stand-in: the bus is simulated behind the HTPA_I2C_* hooks, so only
+// the types and constants htpa.c sees are needed
+
+#include "freertos/FreeRTOS.h"
+
+typedef int esp_err_t;
+typedef int i2c_port_t;
+
+#define ESP_OK      0
+#define ESP_FAIL    -1
+#define I2C_NUM_0   0
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef _ESP32_HAL_H_
+#define _ESP32_HAL_H_
+
+// Host stand-in for the Arduino core, implemented by the htpa_sim test library
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
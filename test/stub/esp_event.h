@@ -0,0 +1,6 @@
+#ifndef _ESP_EVENT_H_
+#define _ESP_EVENT_H_
+
+// Host stand-in, nothing of it is used by the libraries
+
+#endif
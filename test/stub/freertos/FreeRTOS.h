@@ -0,0 +1,40 @@
+#ifndef _FREERTOS_H_
+#define _FREERTOS_H_
+
+// Host stand-in for the FreeRTOS types and heap calls the libraries use,
+// implemented by the htpa_sim test library
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              1
+#define pdFAIL              0
+#define portMAX_DELAY       0xFFFFFFFF
+#define portTICK_PERIOD_MS  1
+#define portTICK_RATE_MS    1
+#define pdMS_TO_TICKS(ms)   (ms)
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void heap_caps_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
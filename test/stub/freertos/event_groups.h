@@ -0,0 +1,6 @@
+#ifndef _FREERTOS_EVENT_GROUPS_H_
+#define _FREERTOS_EVENT_GROUPS_H_
+
+#include "FreeRTOS.h"
+
+#endif
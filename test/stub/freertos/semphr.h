@@ -0,0 +1,18 @@
+#ifndef _FREERTOS_SEMPHR_H_
+#define _FREERTOS_SEMPHR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "FreeRTOS.h"
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef _FREERTOS_TASK_H_
+#define _FREERTOS_TASK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+// a thread on the host, priority and core are ignored
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *task, BaseType_t core);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef _AGC_GOLDEN_H_
+#define _AGC_GOLDEN_H_
+
+#include <stdint.h>
+#include "htpa.h"
+
+// Palette indices of the test scenes, printed by test_main.c built with
+// -DAGC_PRINT_GOLDEN (plateau 16, first frame)
+
+static const uint8_t AgcGoldenObject[HTPA_ROWS][HTPA_COLS] = {
+    {  21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48 },
+    {  58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43 },
+    {  53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37 },
+    {  48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32 },
+    {  43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26 },
+    {  37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21 },
+    {  32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58 },
+    {  26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53 },
+    {  21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48 },
+    {  58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43 },
+    {  53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 87, 88, 90, 96,103,110,117,124, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37 },
+    {  48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 92, 99,106,113,119,128,138,148, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32 },
+    {  43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48,109,115,122,132,142,152,159,167, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26 },
+    {  37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43,126,136,146,155,162,171,181,191, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21 },
+    {  32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37,150,158,165,175,185,195,202,209, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58 },
+    {  26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32,169,179,189,198,204,213,223,231, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53 },
+    {  21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26,193,200,207,217,226,234,240,244, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48 },
+    {  58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21,211,221,229,237,242,246,250,253, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43 },
+    {  53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37 },
+    {  48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32 },
+    {  43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26 },
+    {  37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21 },
+    {  32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58 },
+    {  26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53 },
+    {  21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48 },
+    {  58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43 },
+    {  53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37 },
+    {  48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32 },
+    {  43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26 },
+    {  37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21 },
+    {  32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58 },
+    {  26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53, 26, 43, 58, 32, 48, 21, 37, 53 },
+};
+
+static const uint8_t AgcGoldenGradient[HTPA_ROWS][HTPA_COLS] = {
+    {   0,  0,  0,  0,  1,  1,  1,  2,  2,  2,  3,  3,  4,  4,  5,  6,  7,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17, 19, 20, 21, 22 },
+    {   2,  2,  2,  3,  3,  3,  4,  5,  6,  6,  7,  8,  9,  9, 10, 11, 13, 14, 15, 16, 17, 18, 19, 20, 22, 23, 24, 25, 26, 27, 29, 30 },
+    {   5,  5,  6,  7,  8,  8,  9, 10, 11, 12, 13, 14, 16, 17, 18, 19, 20, 21, 22, 23, 25, 26, 27, 28, 30, 31, 32, 33, 35, 36, 37, 38 },
+    {  10, 11, 12, 13, 14, 15, 16, 17, 19, 20, 21, 22, 23, 24, 25, 26, 28, 29, 31, 32, 33, 34, 35, 36, 38, 39, 40, 41, 42, 43, 45, 46 },
+    {  17, 18, 19, 20, 22, 23, 24, 25, 26, 27, 29, 30, 32, 33, 34, 35, 36, 37, 38, 39, 41, 42, 43, 44, 46, 47, 48, 49, 51, 52, 53, 54 },
+    {  25, 26, 27, 28, 30, 31, 32, 33, 35, 36, 37, 38, 39, 40, 41, 42, 44, 45, 47, 48, 49, 50, 51, 52, 54, 55, 56, 57, 58, 59, 61, 62 },
+    {  33, 34, 35, 36, 38, 39, 40, 41, 42, 43, 45, 46, 48, 49, 50, 51, 52, 53, 54, 55, 57, 58, 59, 60, 62, 63, 64, 65, 66, 67, 69, 70 },
+    {  41, 42, 43, 44, 46, 47, 48, 49, 51, 52, 53, 54, 55, 56, 57, 58, 60, 61, 63, 64, 65, 65, 67, 68, 70, 71, 72, 73, 74, 75, 76, 77 },
+    {  49, 50, 51, 52, 54, 55, 56, 57, 58, 59, 61, 62, 64, 64, 65, 66, 68, 69, 70, 71, 73, 74, 75, 76, 77, 78, 79, 80, 82, 83, 85, 86 },
+    {  57, 58, 59, 60, 62, 63, 64, 65, 66, 67, 69, 70, 71, 72, 73, 74, 76, 77, 78, 79, 80, 81, 83, 84, 86, 87, 88, 89, 90, 91, 92, 93 },
+    {  65, 65, 67, 68, 70, 71, 72, 73, 74, 75, 76, 77, 79, 80, 81, 82, 84, 85, 86, 87, 89, 90, 91, 92, 93, 94, 95, 96, 98, 99,101,102 },
+    {  73, 74, 75, 76, 77, 78, 79, 80, 82, 83, 85, 86, 87, 88, 89, 90, 92, 93, 94, 95, 96, 97, 99,100,102,103,104,105,106,107,108,109 },
+    {  80, 81, 83, 84, 86, 87, 88, 89, 90, 91, 92, 93, 95, 96, 97, 98,100,101,102,103,105,106,107,108,109,110,111,112,114,115,117,118 },
+    {  89, 90, 91, 92, 93, 94, 95, 96, 98, 99,101,102,103,104,105,106,108,109,110,111,112,113,115,116,118,119,120,121,122,123,124,125 },
+    {  96, 97, 99,100,102,103,104,105,106,107,108,109,111,112,113,114,116,117,118,119,121,122,123,124,125,126,127,128,130,131,132,133 },
+    { 105,106,107,108,109,110,111,112,114,115,117,118,119,120,121,122,124,125,126,127,128,129,130,131,133,134,135,136,138,139,140,141 },
+    { 112,113,115,116,118,119,120,121,122,123,124,125,127,128,129,130,131,132,133,134,136,137,139,140,141,142,143,144,146,147,148,149 },
+    { 121,122,123,124,125,126,127,128,130,131,132,133,134,135,137,138,140,141,142,143,144,145,146,147,149,150,151,152,154,155,156,157 },
+    { 128,129,130,131,133,134,135,136,138,139,140,141,143,144,145,146,147,148,149,150,152,153,155,156,157,158,159,160,162,163,164,165 },
+    { 136,137,139,140,141,142,143,144,146,147,148,149,150,151,153,154,156,157,158,159,160,161,162,163,165,166,167,168,170,171,172,173 },
+    { 144,145,146,147,149,150,151,152,154,155,156,157,159,160,161,162,163,164,165,166,168,169,171,172,173,174,175,176,178,179,180,181 },
+    { 152,153,155,156,157,158,159,160,162,163,164,165,166,167,169,170,172,173,174,175,176,177,178,179,181,182,183,184,186,187,188,189 },
+    { 160,161,162,163,165,166,167,168,170,171,172,173,175,176,177,178,179,180,181,182,184,185,187,188,189,190,191,192,194,195,196,197 },
+    { 168,169,171,172,173,174,175,176,178,179,180,181,182,183,185,186,188,189,190,191,192,193,194,195,197,198,199,200,202,203,204,205 },
+    { 176,177,178,179,181,182,183,184,186,187,188,189,191,192,193,194,195,196,197,198,200,201,203,204,205,206,207,208,210,211,212,213 },
+    { 184,185,187,188,189,190,191,192,194,195,196,197,198,199,201,202,204,205,206,207,208,209,210,211,213,214,215,216,218,219,220,221 },
+    { 192,193,194,195,197,198,199,200,202,203,204,205,207,208,209,210,211,212,213,214,216,217,219,220,221,222,223,224,226,227,228,229 },
+    { 200,201,203,204,205,206,207,208,210,211,212,213,214,215,217,218,220,221,222,223,224,225,226,227,229,230,231,232,234,235,236,237 },
+    { 208,209,210,211,213,214,215,216,218,219,220,221,223,224,225,226,227,228,229,230,232,233,235,236,237,238,239,240,241,242,243,244 },
+    { 216,217,219,220,221,222,223,224,226,227,228,229,230,231,233,234,236,237,238,239,240,240,241,242,244,244,245,246,247,247,248,249 },
+    { 224,225,226,227,229,230,231,232,234,235,236,237,239,239,240,241,242,243,244,245,246,246,247,248,249,249,250,251,252,252,252,253 },
+    { 232,233,235,236,237,238,239,240,241,242,243,244,245,245,246,247,248,248,249,250,251,251,252,252,253,253,253,254,254,254,255,255 },
+};
+
+static const uint8_t AgcGoldenSky[HTPA_ROWS][HTPA_COLS] = {
+    {   0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23 },
+    {  10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35 },
+    {  21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45 },
+    {  32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56 },
+    {  43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2 },
+    {  54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12 },
+    {   0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23 },
+    {  10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35 },
+    {  21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45 },
+    {  32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56 },
+    {  43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2 },
+    {  54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12 },
+    {   0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23 },
+    {  10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35 },
+    {  21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45 },
+    {  32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56 },
+    {  43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2 },
+    {  54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12 },
+    {   0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35, 58, 17, 41,  0, 23 },
+    {  10, 35, 58, 17, 41,  0, 23, 47,  6, 30, 54, 12, 37, 61, 19, 43,  2, 26, 49,  8, 32, 56, 14, 39, 63, 21, 45,  4, 28, 52, 10, 35 },
+    {  72, 95, 81,109, 93, 79,107, 91, 78,104, 89, 76,102, 87, 75,100, 85, 74, 98, 83, 72, 95, 81,109, 93, 79,107, 91, 78,104, 89, 76 },
+    {  81,109, 93,122,107, 91,120,104, 89,118,102, 87,116,100, 85,113, 98, 83,111, 95, 81,109, 93,122,107, 91,120,104, 89,118,102, 87 },
+    {  93,122,107,135,120,104,133,118,102,130,116,100,128,113, 98,126,111, 95,124,109, 93,122,107,135,120,104,133,118,102,130,116,100 },
+    { 107,135,120,147,133,118,145,130,116,143,128,113,141,126,111,139,124,109,137,122,107,135,120,147,133,118,145,130,116,143,128,113 },
+    { 120,147,133,161,145,130,159,143,128,156,141,126,154,139,124,152,137,122,150,135,120,147,133,161,145,130,159,143,128,156,141,126 },
+    { 133,161,145,174,159,143,172,156,141,170,154,139,168,152,137,165,150,135,163,147,133,161,145,174,159,143,172,156,141,170,154,139 },
+    { 145,174,159,187,172,156,185,170,154,182,168,152,180,165,150,178,163,147,176,161,145,174,159,187,172,156,185,170,154,182,168,152 },
+    { 159,187,172,200,185,170,198,182,168,196,180,165,194,178,163,191,176,161,189,174,159,187,172,200,185,170,198,182,168,196,180,165 },
+    { 172,200,185,213,198,182,211,196,180,209,194,178,207,191,176,205,189,174,203,187,172,200,185,213,198,182,211,196,180,209,194,178 },
+    { 185,213,198,226,211,196,224,209,194,222,207,191,220,205,189,217,203,187,215,200,185,213,198,226,211,196,224,209,194,222,207,191 },
+    { 198,226,211,240,224,209,238,222,207,235,220,205,233,217,203,231,215,200,229,213,198,226,211,240,224,209,238,222,207,235,220,205 },
+    { 211,240,224,252,238,222,250,235,220,248,233,217,246,231,215,244,229,213,242,226,211,240,224,252,238,222,250,235,220,248,233,217 },
+};
+
+#endif
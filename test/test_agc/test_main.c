@@ -0,0 +1,210 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "render.h"
+#include "palette.h"
+#include "agc_golden.h"
+
+// Histogram equalising AGC: palette indices of fixed scenes against golden
+// images, and the properties of the curve. Build with -DAGC_PRINT_GOLDEN to
+// print agc_golden.h after an intended change of the AGC.
+
+#define PLATEAU     16
+#define RATE        32
+#define THRESHOLD   2
+
+static int16_t frame[HTPA_ROWS][HTPA_COLS];
+static HTPA_Stats_t stats;
+static Render_Agc_t agc;
+static Render_Map_t map;
+static uint8_t indices[HTPA_ROWS][HTPA_COLS];
+
+void setUp(void) {
+    Render_AgcInit(&agc, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, PLATEAU, RATE, THRESHOLD);
+}
+
+void tearDown(void) {}
+
+// Room background with a little ripple and a warm object
+static int16_t SceneObject(int i, int j) {
+    if (i >= 10 && i < 18 && j >= 12 && j < 20) return 3082 + (i - 10) * 12 + (j - 12) * 5;
+    return 2952 + (i * 7 + j * 3) % 8;
+}
+
+static int16_t SceneGradient(int i, int j) {
+    return 2832 + i * 20 + j * 3;
+}
+
+// Cold sky over a warm foreground
+static int16_t SceneSky(int i, int j) {
+    if (i < 20) return 2532 + (i * 5 + j * 11) % 30;
+    return 2982 + (i - 20) * 6 + (j * 13) % 20;
+}
+
+static void LoadScene(int16_t (*scene)(int i, int j), int16_t offset) {
+    memset(&stats, 0, sizeof(stats));
+    stats.minTemp = INT16_MAX;
+    stats.maxTemp = INT16_MIN;
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            int16_t t = scene(i, j) + offset;
+            frame[i][j] = t;
+            if (t < stats.minTemp) stats.minTemp = t;
+            if (t > stats.maxTemp) stats.maxTemp = t;
+            stats.sum += t;
+            int32_t bin = (t - HTPA_HIST_BASE) >> HTPA_HIST_SHIFT;
+            stats.hist[bin < 0 ? 0 : bin >= HTPA_HIST_BINS ? HTPA_HIST_BINS - 1 : bin]++;
+        }
+    }
+    stats.meanTemp = stats.sum / HTPA_PIXELS;
+}
+
+static void MapFrame(const Render_Map_t *m) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) indices[i][j] = Render_MapIndex(m, frame[i][j]);
+    }
+}
+
+static void CheckGolden(const char *name, int16_t (*scene)(int i, int j), const uint8_t golden[HTPA_ROWS][HTPA_COLS]) {
+    LoadScene(scene, 0);
+    TEST_ASSERT_TRUE(Render_AgcUpdate(&agc, &stats, &map));
+    MapFrame(&map);
+#ifdef AGC_PRINT_GOLDEN
+    printf("static const uint8_t %s[HTPA_ROWS][HTPA_COLS] = {\n", name);
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        printf("    {");
+        for (int j = 0; j < HTPA_COLS; j++) printf("%s%3u", j ? "," : " ", indices[i][j]);
+        printf(" },\n");
+    }
+    printf("};\n\n");
+#else
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&golden[0][0], &indices[0][0], HTPA_PIXELS);
+#endif
+}
+
+static void test_golden_object(void) {
+    CheckGolden("AgcGoldenObject", SceneObject, AgcGoldenObject);
+}
+
+static void test_golden_gradient(void) {
+    CheckGolden("AgcGoldenGradient", SceneGradient, AgcGoldenGradient);
+}
+
+static void test_golden_sky(void) {
+    CheckGolden("AgcGoldenSky", SceneSky, AgcGoldenSky);
+}
+
+// The curve never falls and covers the palette from the bin of the coldest
+// pixel to the bin of the hottest
+static void test_curve_is_monotonic_and_full(void) {
+    int16_t (*scenes[])(int i, int j) = { SceneObject, SceneGradient, SceneSky };
+
+    for (size_t n = 0; n < sizeof(scenes) / sizeof(scenes[0]); n++) {
+        Render_AgcInit(&agc, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, PLATEAU, RATE, THRESHOLD);
+        LoadScene(scenes[n], 0);
+        Render_AgcUpdate(&agc, &stats, &map);
+        for (int k = 1; k < RENDER_AGC_POINTS; k++) TEST_ASSERT_TRUE(map.curve[k] >= map.curve[k - 1]);
+        const int16_t edge = ~((1 << HTPA_HIST_SHIFT) - 1);
+        int16_t low = HTPA_HIST_BASE + ((stats.minTemp - HTPA_HIST_BASE) & edge);
+        int16_t high = HTPA_HIST_BASE + ((stats.maxTemp - HTPA_HIST_BASE) & edge) + (1 << HTPA_HIST_SHIFT);
+        TEST_ASSERT_EQUAL_UINT16(0, Render_MapIndex(&map, low));
+        TEST_ASSERT_EQUAL_UINT16(PALETTE_SIZE - 1, Render_MapIndex(&map, high));
+        TEST_ASSERT_EQUAL_PTR(agc.palette, map.palette);
+    }
+}
+
+// Palette entries between the coldest and hottest pixel of the object or the background
+static int IndexSpan(bool object) {
+    int lo = PALETTE_SIZE, hi = -1;
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            bool inside = i >= 10 && i < 18 && j >= 12 && j < 20;
+            if (inside != object) continue;
+            if (indices[i][j] < lo) lo = indices[i][j];
+            if (indices[i][j] > hi) hi = indices[i][j];
+        }
+    }
+    return hi - lo;
+}
+
+// The linear map spends the palette evenly on the range between background
+// and object, the AGC stretches the crowded background
+static void test_detail_beats_linear(void) {
+    Render_Map_t linear;
+
+    LoadScene(SceneObject, 0);
+    Render_MapInit(&linear, agc.palette, PALETTE_SIZE, stats.minTemp, stats.maxTemp);
+    MapFrame(&linear);
+    int linear_background = IndexSpan(false);
+
+    Render_AgcUpdate(&agc, &stats, &map);
+    MapFrame(&map);
+    TEST_ASSERT_GREATER_THAN(4 * linear_background, IndexSpan(false));
+}
+
+// Clipping the large background bins leaves more of the palette to the object
+static void test_plateau_favours_small_objects(void) {
+    LoadScene(SceneObject, 0);
+    Render_AgcInit(&agc, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 0, RATE, THRESHOLD);
+    Render_AgcUpdate(&agc, &stats, &map);
+    MapFrame(&map);
+    int plain = IndexSpan(true);
+
+    Render_AgcInit(&agc, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, PLATEAU, RATE, THRESHOLD);
+    Render_AgcUpdate(&agc, &stats, &map);
+    MapFrame(&map);
+    TEST_ASSERT_GREATER_THAN(plain, IndexSpan(true));
+}
+
+// After a scene change the curve moves over at RATE/256 per frame and ends
+// on the curve a fresh AGC gives right away
+static void test_curve_follows_smoothly(void) {
+    static Render_Agc_t fresh;
+    Render_Map_t target;
+
+    LoadScene(SceneObject, 0);
+    Render_AgcUpdate(&agc, &stats, &map);
+    LoadScene(SceneObject, 80);
+    Render_AgcInit(&fresh, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, PLATEAU, RATE, THRESHOLD);
+    Render_AgcUpdate(&fresh, &stats, &target);
+
+    Render_AgcUpdate(&agc, &stats, &map);
+    int first_step = 0;
+    for (int k = 0; k < RENDER_AGC_POINTS; k++) {
+        int d = abs((int)target.curve[k] - map.curve[k]);
+        if (d > first_step) first_step = d;
+    }
+    TEST_ASSERT_GREATER_THAN(THRESHOLD, first_step);
+
+    for (int n = 0; n < 200; n++) Render_AgcUpdate(&agc, &stats, &map);
+    for (int k = 0; k < RENDER_AGC_POINTS; k++) TEST_ASSERT_INT_WITHIN(THRESHOLD, target.curve[k], map.curve[k]);
+}
+
+// Drift below the threshold keeps the curve in use, so the image is not redrawn
+static void test_small_drift_keeps_the_curve(void) {
+    LoadScene(SceneGradient, 0);
+    TEST_ASSERT_TRUE(Render_AgcUpdate(&agc, &stats, &map));
+    const uint16_t *curve = map.curve;
+
+    for (int n = 0; n < 20; n++) {
+        TEST_ASSERT_FALSE(Render_AgcUpdate(&agc, &stats, &map));
+        TEST_ASSERT_EQUAL_PTR(curve, map.curve);
+    }
+    LoadScene(SceneGradient, 200);
+    TEST_ASSERT_TRUE(Render_AgcUpdate(&agc, &stats, &map));
+    TEST_ASSERT_TRUE(curve != map.curve);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_golden_object);
+    RUN_TEST(test_golden_gradient);
+    RUN_TEST(test_golden_sky);
+    RUN_TEST(test_curve_is_monotonic_and_full);
+    RUN_TEST(test_detail_beats_linear);
+    RUN_TEST(test_plateau_favours_small_objects);
+    RUN_TEST(test_curve_follows_smoothly);
+    RUN_TEST(test_small_drift_keeps_the_curve);
+    return UNITY_END();
+}
@@ -0,0 +1,209 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "render.h"
+
+// Damped autoscale against recorded scene ranges: a step up approaches the
+// new bound geometrically at ATTACK/256 per frame, a step down at DECAY/256 of
+// the distance beyond the hysteresis, and neither ever overshoots.
+
+#define ATTACK      96              // as in main.cpp
+#define DECAY       8
+#define HYSTERESIS  15
+
+static Render_Autoscale_t scale;
+static HTPA_Stats_t stats;
+static int16_t low, high;
+
+void setUp(void) {
+    Render_AutoscaleInit(&scale, 0, ATTACK, DECAY, HYSTERESIS, 20);
+}
+
+void tearDown(void) {}
+
+// One frame of a scene spanning min..max; without ignored pixels only the
+// extremes count
+static void Update(int16_t min, int16_t max) {
+    memset(&stats, 0, sizeof(stats));
+    stats.minTemp = min;
+    stats.maxTemp = max;
+    Render_AutoscaleUpdate(&scale, &stats, &low, &high);
+}
+
+// Distance left after n frames moving rate/256 of it per frame
+static double Remaining(double distance, int rate, int n) {
+    return distance * pow(1 - rate / 256.0, n);
+}
+
+static void test_first_frame_takes_the_scene(void) {
+    Update(2950, 3050);
+    TEST_ASSERT_EQUAL_INT16(2950, low);
+    TEST_ASSERT_EQUAL_INT16(3050, high);
+}
+
+// Hotter scene: the upper bound closes ATTACK/256 of the gap each frame
+static void test_step_up_attacks(void) {
+    Update(2950, 3050);
+    for (int n = 1; n <= 40; n++) {
+        Update(2950, 3250);
+        char msg[48];
+        snprintf(msg, sizeof(msg), "frame %d: %d..%d", n, low, high);
+        TEST_ASSERT_INT_WITHIN_MESSAGE(1, lround(3250 - Remaining(200, ATTACK, n)), high, msg);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(3250, high, msg);
+        TEST_ASSERT_EQUAL_INT16_MESSAGE(2950, low, msg);
+    }
+    TEST_ASSERT_EQUAL_INT16(3250, high);
+
+    // and a colder one pulls the lower bound the same way
+    for (int n = 1; n <= 40; n++) {
+        Update(2850, 3250);
+        TEST_ASSERT_INT_WITHIN(1, lround(2850 + Remaining(100, ATTACK, n)), low);
+        TEST_ASSERT_GREATER_OR_EQUAL(2850, low);
+    }
+}
+
+// Cooler scene: the upper bound decays towards HYSTERESIS above it
+static void test_step_down_decays(void) {
+    Update(2950, 3250);
+    for (int n = 1; n <= 400; n++) {
+        Update(2950, 3050);
+        char msg[48];
+        snprintf(msg, sizeof(msg), "frame %d: %d..%d", n, low, high);
+        TEST_ASSERT_INT_WITHIN_MESSAGE(1, lround(3050 + HYSTERESIS + Remaining(200 - HYSTERESIS, DECAY, n)), high, msg);
+        TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(3050 + HYSTERESIS, high, msg);
+    }
+    // a scene moving inside the hysteresis leaves the range alone
+    for (int n = 0; n < 50; n++) {
+        Update(2950 + n % 10, 3050 + n % 10);
+        TEST_ASSERT_EQUAL_INT16(2950, low);
+        TEST_ASSERT_INT_WITHIN(1, 3050 + HYSTERESIS, high);
+    }
+}
+
+// A single hot frame takes ATTACK/256 of its excursion, which then decays
+// without ever dropping below where it started
+static void test_hot_transient(void) {
+    for (int n = 0; n < 10; n++) Update(2950, 3050);
+    Update(2950, 3500);
+    TEST_ASSERT_INT_WITHIN(1, lround(3500 - Remaining(450, ATTACK, 1)), high);
+
+    int16_t last = high;
+    for (int n = 1; n <= 300; n++) {
+        Update(2950, 3050);
+        TEST_ASSERT_TRUE(high <= last);
+        TEST_ASSERT_INT_WITHIN(1, lround(3050 + HYSTERESIS + Remaining(last - 3050 - HYSTERESIS, DECAY, 1)), high);
+        TEST_ASSERT_GREATER_OR_EQUAL(3050 + HYSTERESIS, high);
+        TEST_ASSERT_EQUAL_INT16(2950, low);
+        last = high;
+    }
+}
+
+// Scene warming up by 1 dK per frame: the upper bound trails by
+// (256 - ATTACK) / ATTACK dK, the lower one by HYSTERESIS + 256 / DECAY,
+// both stay inside the last frame's range extended by that lag
+static void test_slow_drift(void) {
+    for (int n = 0; n < 10; n++) Update(2950, 3050);
+    for (int n = 1; n <= 400; n++) {
+        int16_t min = 2950 + n, max = 3050 + n;
+        Update(min, max);
+        char msg[48];
+        snprintf(msg, sizeof(msg), "frame %d: %d..%d", n, low, high);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(max, high, msg);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(min, low, msg);
+        if (n < 200) continue;
+        TEST_ASSERT_INT_WITHIN_MESSAGE(1, max - (256 - ATTACK) / (double)ATTACK, high, msg);
+        TEST_ASSERT_INT_WITHIN_MESSAGE(2, min - HYSTERESIS - 256 / DECAY, low, msg);
+    }
+}
+
+// Narrow scenes are widened to the minimum span around their centre
+static void test_minimum_span(void) {
+    Render_AutoscaleInit(&scale, 0, ATTACK, DECAY, HYSTERESIS, 200);
+    Update(3000, 3000);
+    TEST_ASSERT_EQUAL_INT16(2900, low);
+    TEST_ASSERT_EQUAL_INT16(3100, high);
+    Update(2990, 3030);
+    TEST_ASSERT_EQUAL_INT16(200, high - low);
+    TEST_ASSERT_TRUE(low <= 2990 && high >= 3030);
+}
+
+// Whole degree labels of a jittering scene: the raw extremes move them in
+// most frames, the damped range hardly ever once settled
+static void test_jitter_keeps_the_labels(void) {
+    uint32_t rng = 5;
+    int raw = 0, damped = 0;
+    long lastRaw = 0, lastDamped = 0;
+
+    for (int n = 0; n < 600; n++) {
+        rng = rng * 1103515245 + 12345;
+        int16_t min = 2950 + (int)((rng >> 16) % 11) - 5;
+        int16_t max = 3050 + (int)((rng >> 8) % 11) - 5;
+        Update(min, max);
+        long labelsRaw = lroundf(HTPA_DK_TO_C(min)) * 1000 + lroundf(HTPA_DK_TO_C(max));
+        long labelsDamped = lroundf(HTPA_DK_TO_C(low)) * 1000 + lroundf(HTPA_DK_TO_C(high));
+        if (n >= 100) {
+            raw += labelsRaw != lastRaw;
+            damped += labelsDamped != lastDamped;
+        }
+        lastRaw = labelsRaw;
+        lastDamped = labelsDamped;
+    }
+    char msg[64];
+    snprintf(msg, sizeof(msg), "label changes in 500 frames: raw %d, damped %d", raw, damped);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN_MESSAGE(200, raw, msg);
+    TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(2, damped, msg);
+}
+
+// Scene with statistics as HTPA_CaptureData gathers them
+static void LoadScene(int16_t background, int hot, int16_t hotTemp) {
+    memset(&stats, 0, sizeof(stats));
+    stats.minTemp = INT16_MAX;
+    stats.maxTemp = INT16_MIN;
+    for (int p = 0; p < HTPA_PIXELS; p++) {
+        int16_t t = p < hot ? hotTemp : background + (p * 7) % 50;
+        if (t < stats.minTemp) stats.minTemp = t;
+        if (t > stats.maxTemp) stats.maxTemp = t;
+        stats.sum += t;
+        int32_t bin = (t - HTPA_HIST_BASE) >> HTPA_HIST_SHIFT;
+        stats.hist[bin < 0 ? 0 : bin >= HTPA_HIST_BINS ? HTPA_HIST_BINS - 1 : bin]++;
+    }
+    stats.meanTemp = stats.sum / HTPA_PIXELS;
+}
+
+// The ignored pixels keep a few hot ones out of the range, up to the
+// histogram bin the level is read from, a larger object gets in
+static void test_ignored_pixels(void) {
+    Render_AutoscaleInit(&scale, 4, ATTACK, DECAY, HYSTERESIS, 20);
+    LoadScene(2950, 0, 0);
+    Render_AutoscaleUpdate(&scale, &stats, &low, &high);
+    const int16_t settledLow = low, settledHigh = high;
+    TEST_ASSERT_TRUE(low >= 2950 && low < 2950 + (1 << HTPA_HIST_SHIFT));
+    TEST_ASSERT_TRUE(high <= 2999 && high > 2999 - (1 << HTPA_HIST_SHIFT));
+
+    for (int n = 0; n < 20; n++) {
+        LoadScene(2950, 4, 3500);
+        Render_AutoscaleUpdate(&scale, &stats, &low, &high);
+        TEST_ASSERT_EQUAL_INT16(settledLow, low);
+        TEST_ASSERT_INT_WITHIN(1 << HTPA_HIST_SHIFT, settledHigh, high);
+    }
+
+    const int16_t before = high;
+    LoadScene(2950, 16, 3500);
+    Render_AutoscaleUpdate(&scale, &stats, &low, &high);
+    TEST_ASSERT_INT_WITHIN(1, lround(3500 - Remaining(3500 - before, ATTACK, 1)), high);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_takes_the_scene);
+    RUN_TEST(test_step_up_attacks);
+    RUN_TEST(test_step_down_decays);
+    RUN_TEST(test_hot_transient);
+    RUN_TEST(test_slow_drift);
+    RUN_TEST(test_minimum_span);
+    RUN_TEST(test_jitter_keeps_the_labels);
+    RUN_TEST(test_ignored_pixels);
+    return UNITY_END();
+}
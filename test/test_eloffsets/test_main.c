@@ -0,0 +1,118 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+
+// Electrical offset refresh: blind frames only every HTPA_ELOFFSET_PERIOD or
+// after PTAT drift, and temperatures that stay within tolerance while the
+// blind level drifts in between.
+
+// Temperature error allowed from offsets that went stale since the last refresh
+#define DRIFT_TOLERANCE_DK  2
+
+static HTPA_Data_t data;
+static HTPA_EEPROM_Data_t eeprom;
+static HTPA_Data_t stale, fresh;
+
+void setUp(void) {
+    HTPA_SimReset(114);
+    sim_signal = 2000;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+    HTPA_SetFilter(false);
+    HTPA_SetOversampling(1);
+
+    // settle: first PTAT, VDD and offsets
+    for (int n = 0; n < 3; n++) TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+}
+
+void tearDown(void) {}
+
+// The period is checked when a frame starts and measured from the blind
+// readout inside a frame, so refreshes come every period plus up to two frames
+static void test_steady_scene_refreshes_by_period(void) {
+    uint32_t blind = sim_blind_conversions;
+    uint64_t start = sim_us;
+    int frames = 0;
+
+    while (sim_us - start < 10 * HTPA_ELOFFSET_PERIOD * 1000ULL) {
+        TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+        frames++;
+    }
+    uint32_t refreshes = sim_blind_conversions - blind;
+    char msg[64];
+    snprintf(msg, sizeof(msg), "%d frames, %u blind frames", frames, (unsigned)refreshes);
+    TEST_MESSAGE(msg);
+    uint32_t frame_ms = 10 * HTPA_ELOFFSET_PERIOD / frames;
+    TEST_ASSERT_GREATER_THAN(3 * 10, frames);
+    TEST_ASSERT_GREATER_OR_EQUAL(10 * HTPA_ELOFFSET_PERIOD / (HTPA_ELOFFSET_PERIOD + 2 * frame_ms), refreshes);
+    TEST_ASSERT_LESS_OR_EQUAL(10 + 1, refreshes);
+}
+
+// Drift is judged on the averages of the previous frame
+static void test_ptat_drift_refreshes_early(void) {
+    // right after a periodic refresh
+    uint32_t blind = sim_blind_conversions;
+    while (sim_blind_conversions == blind) TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+
+    blind = sim_blind_conversions;
+    sim_ptat += HTPA_ELOFFSET_PTAT_DRIFT / 2;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL_UINT32(blind, sim_blind_conversions);
+
+    sim_ptat += HTPA_ELOFFSET_PTAT_DRIFT;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL_UINT32(blind + 1, sim_blind_conversions);
+}
+
+// Ambient warms up and the blind level follows it, 1 count per 10 PTAT
+// counts, plus a slow drift of its own. Each frame is compared with the same
+// raw frame calibrated with offsets read right then. The blind readout moves
+// by the same amount for every blind pixel, so the fresh offsets are the
+// stale ones moved by the drift since the last refresh.
+static void test_temperatures_within_tolerance_under_drift(void) {
+    int eo_at_refresh = sim_eo, worst = 0;
+    uint32_t blind = sim_blind_conversions;
+    const int base_eo = sim_eo, base_ptat = sim_ptat;
+
+    for (int n = 0; n < 200; n++) {
+        sim_ptat += 3;
+        sim_eo = base_eo + (sim_ptat - base_ptat) / 10 + n / 20;
+        TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+        if (sim_blind_conversions != blind) {
+            blind = sim_blind_conversions;
+            eo_at_refresh = sim_eo;
+        }
+
+        stale = data;
+        fresh = data;
+        for (int i = 0; i < HTPA_BLOCKS * 2; i++) {
+            for (int j = 0; j < HTPA_COLS; j++) fresh.electricalOffsets[i][j] += sim_eo - eo_at_refresh;
+        }
+        HTPA_CalculateTemperaturesDouble(&stale, &eeprom, NULL);
+        HTPA_CalculateTemperaturesDouble(&fresh, &eeprom, NULL);
+        for (int i = 0; i < HTPA_ROWS; i++) {
+            for (int j = 0; j < HTPA_COLS; j++) {
+                int d = abs(stale.pixelTemps[i][j] - fresh.pixelTemps[i][j]);
+                if (d > worst) worst = d;
+            }
+        }
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "worst %d dK from stale offsets", worst);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_OR_EQUAL(DRIFT_TOLERANCE_DK, worst);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_scene_refreshes_by_period);
+    RUN_TEST(test_ptat_drift_refreshes_early);
+    RUN_TEST(test_temperatures_within_tolerance_under_drift);
+    return UNITY_END();
+}
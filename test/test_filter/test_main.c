@@ -0,0 +1,217 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+
+// Motion adaptive temporal filter: noise equivalent temperature difference
+// (NETD, temporal standard deviation of a still pixel) with white noise,
+// bias, moving edges, and switching it at runtime.
+
+#define NETD_FRAMES     2000
+#define SETTLE_FRAMES   100
+
+static HTPA_Data_t data;
+static HTPA_EEPROM_Data_t eeprom;
+static double sum[2][HTPA_PIXELS], sum2[2][HTPA_PIXELS];
+static uint32_t rng;
+
+void setUp(void) {
+    rng = 3;
+}
+
+void tearDown(void) {}
+
+static double Uniform(void) {
+    rng = rng * 1664525 + 1013904223;
+    return (rng + 1.0) / 4294967297.0;
+}
+
+static double Gauss(void) {
+    return sqrt(-2 * log(Uniform())) * cos(2 * M_PI * Uniform());
+}
+
+static void Fill(int16_t temp) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) data.pixelTemps[i][j] = temp;
+    }
+}
+
+// Runs a flat scene until the filter state follows it
+static void Settle(int16_t temp) {
+    for (int n = 0; n < SETTLE_FRAMES; n++) {
+        Fill(temp);
+        HTPA_FilterTemperatures(&data);
+    }
+}
+
+// Still scene with Gaussian white noise of sigma deci Kelvin, NETD in Kelvin
+// before and after the filter and the mean bias it adds
+static void MeasureNetd(double sigma, double *raw, double *filtered, double *bias) {
+    memset(sum, 0, sizeof(sum));
+    memset(sum2, 0, sizeof(sum2));
+    Settle(3000);
+
+    for (int n = 0; n < SETTLE_FRAMES + NETD_FRAMES; n++) {
+        int16_t in[HTPA_PIXELS];
+        for (int p = 0; p < HTPA_PIXELS; p++) {
+            in[p] = lround(3000 + (p % 37) * 3 + Gauss() * sigma);
+            data.pixelTemps[p / HTPA_COLS][p % HTPA_COLS] = in[p];
+        }
+        HTPA_FilterTemperatures(&data);
+        if (n < SETTLE_FRAMES) continue;
+        for (int p = 0; p < HTPA_PIXELS; p++) {
+            double a = in[p] * 0.1, b = data.pixelTemps[p / HTPA_COLS][p % HTPA_COLS] * 0.1;
+            sum[0][p] += a;
+            sum2[0][p] += a * a;
+            sum[1][p] += b;
+            sum2[1][p] += b * b;
+        }
+    }
+
+    double netd[2] = { 0, 0 };
+    *bias = 0;
+    for (int k = 0; k < 2; k++) {
+        for (int p = 0; p < HTPA_PIXELS; p++) {
+            double mean = sum[k][p] / NETD_FRAMES;
+            netd[k] += sqrt(sum2[k][p] / NETD_FRAMES - mean * mean);
+        }
+    }
+    for (int p = 0; p < HTPA_PIXELS; p++) *bias += (sum[1][p] - sum[0][p]) / NETD_FRAMES;
+    *raw = netd[0] / HTPA_PIXELS;
+    *filtered = netd[1] / HTPA_PIXELS;
+    *bias /= HTPA_PIXELS;
+}
+
+static void CheckNetd(double sigma) {
+    double raw, filtered, bias;
+    char msg[96];
+
+    MeasureNetd(sigma, &raw, &filtered, &bias);
+    snprintf(msg, sizeof(msg), "%.1f K noise: NETD %.3f K raw, %.3f K filtered, bias %.4f K",
+             sigma / 10, raw, filtered, bias);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE_MESSAGE(raw >= 3 * filtered, msg);
+    TEST_ASSERT_TRUE_MESSAGE(fabs(bias) < 0.01, msg);
+}
+
+static void test_netd_at_0_1_kelvin(void) {
+    CheckNetd(1);
+}
+
+static void test_netd_at_0_3_kelvin(void) {
+    CheckNetd(3);
+}
+
+// A change above HTPA_FILTER_MOTION passes in the first frame, both ways
+static void test_large_step_passes_at_once(void) {
+    Settle(3000);
+    Fill(3050);
+    HTPA_FilterTemperatures(&data);
+    for (int p = 0; p < HTPA_PIXELS; p++) TEST_ASSERT_EQUAL_INT16(3050, data.pixelTemps[p / HTPA_COLS][p % HTPA_COLS]);
+
+    Fill(3000);
+    HTPA_FilterTemperatures(&data);
+    for (int p = 0; p < HTPA_PIXELS; p++) TEST_ASSERT_EQUAL_INT16(3000, data.pixelTemps[p / HTPA_COLS][p % HTPA_COLS]);
+}
+
+// A small step is smoothed but settles, it never overshoots
+static void test_small_step_settles(void) {
+    Settle(3000);
+    int16_t last = 3000;
+    for (int n = 0; n < 40; n++) {
+        Fill(3010);
+        HTPA_FilterTemperatures(&data);
+        int16_t t = data.pixelTemps[5][5];
+        TEST_ASSERT_TRUE(t >= last && t <= 3010);
+        if (n == 0) TEST_ASSERT_LESS_THAN(3010, t);
+        last = t;
+    }
+    TEST_ASSERT_INT_WITHIN(1, 3010, last);
+    TEST_ASSERT_EQUAL_INT16(last, data.stats.maxTemp);
+}
+
+// HTPA_SetFilter is a request from another task, the sensor task applies it
+// at the start of its next frame. A step in the scene shows whether a frame
+// was filtered: unfiltered it arrives at once, filtered it lags.
+static void test_switch_applies_to_next_capture(void) {
+    HTPA_SimReset(114);
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+    HTPA_SetOversampling(1);
+    HTPA_SetFilter(false);
+    for (int n = 0; n < 3; n++) TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    const int16_t before = data.stats.meanTemp;
+
+    // first filtered frame starts the filter on the frame itself
+    HTPA_SetFilter(true);
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL_INT16(before, data.stats.meanTemp);
+
+    sim_signal += 30;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    const int16_t lagging = data.stats.meanTemp;
+
+    HTPA_SetFilter(false);
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    const int16_t after = data.stats.meanTemp;
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "mean %d, filtered %d, unfiltered %d dK", before, lagging, after);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE_MESSAGE(after - before > HTPA_FILTER_NOISE && after - before < HTPA_FILTER_MOTION, msg);
+    TEST_ASSERT_TRUE_MESSAGE(lagging > before && lagging < after, msg);
+}
+
+// Frames of a noisy scene from a fresh start, filtered or not
+static void CaptureFresh(bool filter, int frames, int16_t temps[][HTPA_ROWS][HTPA_COLS]) {
+    HTPA_SimReset(114);
+    sim_noise = 20;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+    HTPA_SetOversampling(1);
+    HTPA_SetFilter(filter);
+    HTPA_GetLatestFrame();
+
+    // the first capture has no PTAT, it neither publishes nor starts the filter
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+    for (int n = 0; n < frames; n++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+        const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+        TEST_ASSERT_NOT_NULL(frame);
+        memcpy(temps[n], frame->pixelTemps, sizeof(frame->pixelTemps));
+    }
+}
+
+// The filter starts on the first published frame, which passes unchanged,
+// and smooths the noise from the next one on
+static void test_filter_starts_on_first_valid_frame(void) {
+    static int16_t raw[2][HTPA_ROWS][HTPA_COLS], filtered[2][HTPA_ROWS][HTPA_COLS];
+
+    CaptureFresh(false, 2, raw);
+    CaptureFresh(true, 2, filtered);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(&raw[0][0][0], &filtered[0][0][0], HTPA_PIXELS);
+
+    int moved[2] = { 0, 0 };
+    for (int p = 0; p < HTPA_PIXELS; p++) {
+        int16_t before = raw[0][p / HTPA_COLS][p % HTPA_COLS];
+        moved[0] += abs(raw[1][p / HTPA_COLS][p % HTPA_COLS] - before);
+        moved[1] += abs(filtered[1][p / HTPA_COLS][p % HTPA_COLS] - before);
+    }
+    char msg[64];
+    snprintf(msg, sizeof(msg), "frame to frame change %d dK raw, %d dK filtered", moved[0], moved[1]);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE_MESSAGE(moved[1] * 2 < moved[0], msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_netd_at_0_1_kelvin);
+    RUN_TEST(test_netd_at_0_3_kelvin);
+    RUN_TEST(test_large_step_passes_at_once);
+    RUN_TEST(test_small_step_settles);
+    RUN_TEST(test_switch_applies_to_next_capture);
+    RUN_TEST(test_filter_starts_on_first_valid_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,168 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+
+// The fixed point engine against the double reference, for every table
+// number, across the ambient range of the table and its whole AD range.
+// Outputs are rounded to deci Kelvin, so "within 0.05 K of the reference"
+// shows up as at most 0.5 + 0.5 dK between the fixed output and the
+// unrounded reference.
+#define TOLERANCE_DK        1.0
+#define MEAN_TOLERANCE_DK   0.35        // rounding alone gives 0.25
+#define AMBIENT_STEPS       12
+#define FRAMES              8
+
+// PTAT scaling wide enough for the extended ambient range in 16 bit
+#define PTAT_GRADIENT       0.03f
+#define PTAT_OFFSET         2000.0f
+
+static HTPA_Data_t data;
+static HTPA_EEPROM_Data_t eeprom;
+static int16_t fixed[HTPA_ROWS][HTPA_COLS];
+static double exact[HTPA_ROWS][HTPA_COLS];
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void InitSensor(uint16_t TN) {
+    HTPA_SimReset(TN);
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+
+    // lower sensitivities, so the 16 bit pixel range covers the whole table
+    eeprom.PTAT_gradient = PTAT_GRADIENT;
+    eeprom.PTAT_offset = PTAT_OFFSET;
+    eeprom.PixCmin = 2.0e7f;
+    eeprom.PixCmax = 4.0e7f;
+    HTPA_CalculateSensitivity(&eeprom);
+
+    data.VDDav = 31000;
+    for (int i = 0; i < HTPA_BLOCKS * 2; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            data.electricalOffsets[i][j] = 33000 + (i * HTPA_COLS + j) % 50;
+        }
+    }
+}
+
+static void FillPixels(int frame) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            data.pixelData[i][j] = 30000 + ((i * HTPA_COLS + j) * 331 + frame * 7919) % 35000;
+        }
+    }
+}
+
+// Temperature range of the table at the current ambient temperature. Cold
+// rows the sensor model cannot measure at this ambient hold 0 and are left out.
+static void TableRange(const HTPA_Table_t *table, double *lo, double *hi) {
+    double ambient = data.PTATav * eeprom.PTAT_gradient + eeprom.PTAT_offset;
+    uint8_t col = 0;
+    for (int i = 0; i < table->NrOfTaElements; i++) {
+        if (ambient > table->XTATemps[i]) col = i;
+    }
+    double dta = (ambient - table->XTATemps[col]) / table->TaEquidistance;
+
+    const uint16_t *cell = table->TempTable + col;
+    while (!cell[0] || !cell[1]) cell += table->NrOfTaElements;
+    *lo = cell[0] + (cell[1] - cell[0]) * dta + eeprom.GlobalOff;
+    cell = table->TempTable + (table->NrOfAdElements - 1) * table->NrOfTaElements + col;
+    *hi = cell[0] + (cell[1] - cell[0]) * dta + eeprom.GlobalOff;
+}
+
+static void test_fixed_matches_double_for_every_table(void) {
+    int tables = 0;
+
+    for (uint32_t TN = 0; TN <= 0xFFFF; TN++) {
+        const HTPA_Table_t *table = HTPA_FindTable(TN, HTPA_TABLE_VARIANT);
+        if (!table || table->TN != TN) continue;
+        InitSensor(TN);
+        TEST_ASSERT_EQUAL_PTR(table, HTPA_GetTable());
+
+        double worst = 0, sum = 0, coldest = 1, hottest = 0;
+        uint32_t inside = 0, total = 0;
+        const uint16_t first = table->XTATemps[0], last = table->XTATemps[table->NrOfTaElements - 1];
+
+        for (int step = 0; step < AMBIENT_STEPS; step++) {
+            double ambient = first + 1 + (last - first - 2) * step / (AMBIENT_STEPS - 1.0);
+            data.PTATav = lround((ambient - PTAT_OFFSET) / PTAT_GRADIENT);
+            double lo, hi;
+            TableRange(table, &lo, &hi);
+
+            for (int frame = 0; frame < FRAMES; frame++) {
+                FillPixels(frame);
+                HTPA_CalculateTemperatures(&data, &eeprom);
+                memcpy(fixed, data.pixelTemps, sizeof(fixed));
+                HTPA_CalculateTemperaturesDouble(&data, &eeprom, exact);
+
+                for (int i = 0; i < HTPA_ROWS; i++) {
+                    for (int j = 0; j < HTPA_COLS; j++) {
+                        total++;
+                        if (exact[i][j] <= lo || exact[i][j] >= hi) continue;
+                        double err = fabs(fixed[i][j] - exact[i][j]);
+                        if (err > worst) worst = err;
+                        sum += err;
+                        inside++;
+
+                        double position = (exact[i][j] - lo) / (hi - lo);
+                        if (position < coldest) coldest = position;
+                        if (position > hottest) hottest = position;
+                    }
+                }
+            }
+        }
+
+        char msg[160];
+        snprintf(msg, sizeof(msg), "%s (TN %u): %u of %u pixels inside the table, worst %.2f dK, mean %.3f dK",
+                 table->name, (unsigned)TN, (unsigned)inside, (unsigned)total, worst, inside ? sum / inside : 0);
+        TEST_MESSAGE(msg);
+
+        // the sweep reaches both ends of the table
+        TEST_ASSERT_TRUE_MESSAGE(inside > total / 4, msg);
+        TEST_ASSERT_TRUE_MESSAGE(coldest < 0.02 && hottest > 0.98, msg);
+
+        TEST_ASSERT_TRUE_MESSAGE(worst <= TOLERANCE_DK, msg);
+        TEST_ASSERT_TRUE_MESSAGE(sum / inside <= MEAN_TOLERANCE_DK, msg);
+        tables++;
+    }
+    TEST_ASSERT_GREATER_THAN(0, tables);
+}
+
+static double Elapsed(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+// Host numbers only, the double engine is far slower on the ESP32 without a
+// double precision FPU. Steady PTAT and VDD, so the fixed plan is reused.
+static void test_engine_throughput(void) {
+    const int frames = 500;
+    struct timespec start;
+
+    InitSensor(114);
+    data.PTATav = lround((2982 - PTAT_OFFSET) / PTAT_GRADIENT);
+    FillPixels(0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames; n++) HTPA_CalculateTemperatures(&data, &eeprom);
+    double fixed_us = Elapsed(&start) / frames;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames; n++) HTPA_CalculateTemperaturesDouble(&data, &eeprom, NULL);
+    double double_us = Elapsed(&start) / frames;
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "per frame: fixed %.1f us, double %.1f us", fixed_us, double_us);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(fixed_us > 0 && double_us > 0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_matches_double_for_every_table);
+    RUN_TEST(test_engine_throughput);
+    return UNITY_END();
+}
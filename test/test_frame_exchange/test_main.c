@@ -0,0 +1,122 @@
+#include <unity.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <sched.h>
+#include "htpa.h"
+
+// Triple buffered frame exchange between a producer and a consumer thread.
+// Every published frame is filled with one value, so a frame the producer
+// overwrote while the consumer read it shows up as mixed values.
+
+#define RECEIVE     5000
+
+static HTPA_Data_t data;
+static atomic_uint published;
+static atomic_bool holding;
+static atomic_bool stop;
+static atomic_uint published_while_held;
+
+void setUp(void) {
+    atomic_store(&published, 0);
+    atomic_store(&holding, false);
+    atomic_store(&stop, false);
+    atomic_store(&published_while_held, 0);
+}
+
+void tearDown(void) {}
+
+static void *Producer(void *arg) {
+    for (uint32_t n = 1; !atomic_load(&stop); n++) {
+        int16_t value = n & 0x7FFF;
+        for (int i = 0; i < HTPA_ROWS; i++) {
+            for (int j = 0; j < HTPA_COLS; j++) data.pixelTemps[i][j] = value;
+        }
+        data.ambientTemp = value;
+        data.stats.sum = n;
+        HTPA_PublishFrame(&data);
+        atomic_store(&published, n);
+        if (atomic_load(&holding)) atomic_fetch_add(&published_while_held, 1);
+        sched_yield();      // keeps a single core host interleaving
+    }
+    return NULL;
+}
+
+static void test_no_tearing_and_no_producer_stall(void) {
+    pthread_t producer;
+    const struct timespec pause = { 0, 20000 };
+    uint32_t received = 0, last = 0, last_number = 0;
+    bool first = true;
+
+    // drain what earlier runs left behind
+    while (HTPA_GetLatestFrame());
+
+    TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, Producer, NULL));
+    while (received < RECEIVE) {
+        const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+        if (!frame) {
+            sched_yield();
+            continue;
+        }
+        received++;
+
+        // every tenth frame is held for a while, the producer keeps going
+        bool hold = received % 10 == 0;
+        if (hold) atomic_store(&holding, true);
+        for (int pass = 0; pass < (hold ? 5 : 1); pass++) {
+            if (hold) nanosleep(&pause, NULL);
+            int16_t value = frame->pixelTemps[0][0];
+            for (int i = 0; i < HTPA_ROWS; i++) {
+                for (int j = 0; j < HTPA_COLS; j++) {
+                    if (frame->pixelTemps[i][j] != value) TEST_FAIL_MESSAGE("torn frame");
+                }
+            }
+            TEST_ASSERT_EQUAL_INT16(value, frame->ambientTemp);
+            TEST_ASSERT_EQUAL_INT16((int16_t)(frame->stats.sum & 0x7FFF), value);
+        }
+        if (hold) atomic_store(&holding, false);
+
+        // newer frames only, none handed out twice
+        TEST_ASSERT_TRUE(frame->stats.sum > last);
+        TEST_ASSERT_TRUE(first || frame->frameNumber > last_number);
+        last = frame->stats.sum;
+        last_number = frame->frameNumber;
+        first = false;
+    }
+    atomic_store(&stop, true);
+    pthread_join(producer, NULL);
+
+    // the last frame is never lost
+    const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+    if (frame) last = frame->stats.sum;
+    TEST_ASSERT_EQUAL_UINT32(atomic_load(&published), last);
+    TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%u frames received of %u published, %u published while one was held",
+             (unsigned)received, (unsigned)atomic_load(&published), (unsigned)atomic_load(&published_while_held));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN(0, atomic_load(&published_while_held));
+}
+
+static void test_nothing_new_returns_null(void) {
+    while (HTPA_GetLatestFrame());
+    TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+
+    data.stats.sum = 1;
+    HTPA_PublishFrame(&data);
+    data.stats.sum = 2;
+    HTPA_PublishFrame(&data);
+    const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL_INT32(2, frame->stats.sum);
+    TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_new_returns_null);
+    RUN_TEST(test_no_tearing_and_no_producer_stall);
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+
+// Frame statistics gathered inside the calculation pass against a brute force
+// scan of the finished image, with replaced defective pixels, the temporal
+// filter and oversampling.
+
+static HTPA_Data_t data;
+static HTPA_EEPROM_Data_t eeprom;
+
+void setUp(void) {
+    HTPA_SimReset(114);
+    sim_signal = 2000;
+    sim_noise = 3000;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+    HTPA_SetFilter(false);
+    HTPA_SetOversampling(1);
+}
+
+void tearDown(void) {}
+
+static void CheckStats(const HTPA_Stats_t *stats, const int16_t temps[HTPA_ROWS][HTPA_COLS]) {
+    HTPA_Stats_t ref;
+    memset(&ref, 0, sizeof(ref));
+    ref.minTemp = INT16_MAX;
+    ref.maxTemp = INT16_MIN;
+
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            int16_t t = temps[i][j];
+            if (t < ref.minTemp) ref.minTemp = t;
+            if (t > ref.maxTemp) ref.maxTemp = t;
+            ref.sum += t;
+            int32_t bin = (t - HTPA_HIST_BASE) >> HTPA_HIST_SHIFT;
+            if (bin < 0) bin = 0;
+            if (bin >= HTPA_HIST_BINS) bin = HTPA_HIST_BINS - 1;
+            ref.hist[bin]++;
+        }
+    }
+    const int r = HTPA_ROWS / 2, c = HTPA_COLS / 2;
+    int32_t center = temps[r - 1][c - 1] + temps[r - 1][c] + temps[r][c - 1] + temps[r][c];
+
+    TEST_ASSERT_EQUAL_INT16(ref.minTemp, stats->minTemp);
+    TEST_ASSERT_EQUAL_INT16(ref.maxTemp, stats->maxTemp);
+    // any pixel holding the extreme will do
+    TEST_ASSERT_EQUAL_INT16(ref.minTemp, temps[stats->minRow][stats->minCol]);
+    TEST_ASSERT_EQUAL_INT16(ref.maxTemp, temps[stats->maxRow][stats->maxCol]);
+    TEST_ASSERT_EQUAL_INT32(ref.sum, stats->sum);
+    TEST_ASSERT_INT_WITHIN(1, ref.sum / HTPA_PIXELS, stats->meanTemp);
+    TEST_ASSERT_INT_WITHIN(1, center / 4, stats->centerTemp);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(ref.hist, stats->hist, HTPA_HIST_BINS);
+}
+
+static void Capture(int frames) {
+    int checked = 0;
+
+    for (int n = 0; n < frames; n++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+        const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+        if (n < 2 || !frame) continue;      // first PTAT
+        CheckStats(&data.stats, data.pixelTemps);
+        CheckStats(&frame->stats, frame->pixelTemps);
+        checked++;
+    }
+    TEST_ASSERT_GREATER_THAN(0, checked);
+}
+
+static void test_stats_match_brute_force(void) {
+    Capture(12);
+}
+
+static void test_stats_follow_the_filter(void) {
+    HTPA_SetFilter(true);
+    Capture(12);
+}
+
+static void test_stats_with_oversampling(void) {
+    HTPA_SetOversampling(4);
+    Capture(24);
+}
+
+// Defective pixels are left out of the calculation pass and counted once
+// with their replacement
+static void test_defective_pixels_count_once(void) {
+    Capture(4);
+    uint32_t total = 0;
+    for (int n = 0; n < HTPA_HIST_BINS; n++) total += data.stats.hist[n];
+    TEST_ASSERT_EQUAL_UINT32(HTPA_PIXELS, total);
+
+    // replaced by the mean of the neighbours in its mask, up, right, down and left
+    const int row = HTPA_SIM_DEAD_0 >> 5, col = HTPA_SIM_DEAD_0 % 32;
+    int32_t mean = (data.pixelTemps[row - 1][col] + data.pixelTemps[row][col + 1] +
+                    data.pixelTemps[row + 1][col] + data.pixelTemps[row][col - 1]) / 4;
+    TEST_ASSERT_INT_WITHIN(1, mean, data.pixelTemps[row][col]);
+}
+
+// The first capture measures VDD and has no PTAT yet: nothing is calculated
+// or published, and the first frame out has real temperatures
+static void test_first_frame_waits_for_ptat(void) {
+    HTPA_GetLatestFrame();
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL_UINT16(0, data.PTATav);
+    TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+    TEST_ASSERT_EQUAL_INT32(0, data.stats.sum);
+
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_GREATER_THAN(HTPA_HIST_BASE, frame->stats.minTemp);
+    TEST_ASSERT_GREATER_THAN(HTPA_HIST_BASE, frame->ambientTemp);
+    CheckStats(&frame->stats, frame->pixelTemps);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_waits_for_ptat);
+    RUN_TEST(test_stats_match_brute_force);
+    RUN_TEST(test_stats_follow_the_filter);
+    RUN_TEST(test_stats_with_oversampling);
+    RUN_TEST(test_defective_pixels_count_once);
+    return UNITY_END();
+}
@@ -0,0 +1,210 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "render.h"
+#include "palette.h"
+
+// Overlay compositor against hand drawn pixels: glyphs, scaled text, the
+// crosshair and the scale labels, whole or cut into bands like DrawImage.
+// '#' is the item colour, '.' the background, both byte swapped in the buffer.
+
+#define WIDTH       64
+#define HEIGHT      40
+#define INK         RGB565(0xFF, 0xFF, 0xFF)
+#define PAPER       RGB565(0x10, 0x20, 0x30)
+#define SHADOW      RGB565(0, 0, 0)
+
+static uint16_t buf[HEIGHT][WIDTH];
+static uint16_t expected[HEIGHT][WIDTH];
+static Render_Target_t target = { &buf[0][0], WIDTH, HEIGHT, WIDTH };
+static Render_Overlay_t overlay;
+
+// "12.5" in 6x8 cells
+static const char *const Text125[RENDER_CHAR_HEIGHT] = {
+    "..#....###........#####.",
+    ".##...#...#.......#.....",
+    "..#.......#.......####..",
+    "..#......#............#.",
+    "..#.....#.............#.",
+    "..#....#.....##...#...#.",
+    ".###..#####..##....###..",
+    "........................",
+};
+
+// "MAX:"
+static const char *const TextMax[RENDER_CHAR_HEIGHT] = {
+    "#...#..###..#...#.......",
+    "##.##.#...#.#...#..##...",
+    "#.#.#.#...#..#.#...##...",
+    "#.#.#.#...#...#.........",
+    "#...#.#####..#.#...##...",
+    "#...#.#...#.#...#..##...",
+    "#...#.#...#.#...#.......",
+    "........................",
+};
+
+void setUp(void) {
+    Render_OverlayClear(&overlay);
+    Render_Fill(&target, PAPER);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) expected[y][x] = RGB565_SWAP(PAPER);
+    }
+}
+
+void tearDown(void) {}
+
+// Draws art into the expected image at x, y, every art pixel a scale x scale square
+static void Expect(const char *const *art, int rows, int x, int y, int scale, uint16_t color) {
+    for (int r = 0; r < rows * scale; r++) {
+        const char *line = art[r / scale];
+        for (int c = 0; c < (int)strlen(line) * scale; c++) {
+            int px = x + c, py = y + r;
+            if (line[c / scale] != '#' || px < 0 || py < 0 || px >= WIDTH || py >= HEIGHT) continue;
+            expected[py][px] = RGB565_SWAP(color);
+        }
+    }
+}
+
+static void CheckPixels(void) {
+    for (int y = 0; y < HEIGHT; y++) {
+        char msg[32];
+        snprintf(msg, sizeof(msg), "row %d", y);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY_MESSAGE(expected[y], buf[y], WIDTH, msg);
+    }
+}
+
+static void test_fill_is_byte_swapped(void) {
+    Render_Fill(&target, RGB565(0xF8, 0, 0));
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) TEST_ASSERT_EQUAL_HEX16(0x00F8, buf[y][x]);
+    }
+}
+
+static void test_glyphs(void) {
+    Render_OverlayText(&overlay, 3, 2, "12.5", 1, INK);
+    Render_OverlayText(&overlay, 30, 20, "max:", 1, INK);
+    Render_OverlayComposite(&overlay, &target, 0, 0);
+
+    Expect(Text125, RENDER_CHAR_HEIGHT, 3, 2, 1, INK);
+    Expect(TextMax, RENDER_CHAR_HEIGHT, 30, 20, 1, INK);
+    CheckPixels();
+}
+
+// Spot temperature size, cut at the right edge of the target
+static void test_scaled_text_is_clipped(void) {
+    Render_OverlayText(&overlay, 20, 10, "12.5", 2, INK);
+    Render_OverlayComposite(&overlay, &target, 0, 0);
+
+    Expect(Text125, RENDER_CHAR_HEIGHT, 20, 10, 2, INK);
+    CheckPixels();
+}
+
+// Crosshair of DrawCenterTempColor, drop shadow first
+static void AddCrosshair(int cX, int cY, uint16_t color) {
+    const int offMin = 5, offMax = 10, offTwin = 1, len = offMax - offMin + 1;
+
+    Render_OverlayRect(&overlay, cX - offTwin, cY - offMax, 1, len, color);
+    Render_OverlayRect(&overlay, cX + offTwin, cY - offMax, 1, len, color);
+    Render_OverlayRect(&overlay, cX - offTwin, cY + offMin, 1, len, color);
+    Render_OverlayRect(&overlay, cX + offTwin, cY + offMin, 1, len, color);
+    Render_OverlayRect(&overlay, cX - offMax, cY - offTwin, len, 1, color);
+    Render_OverlayRect(&overlay, cX - offMax, cY + offTwin, len, 1, color);
+    Render_OverlayRect(&overlay, cX + offMin, cY - offTwin, len, 1, color);
+    Render_OverlayRect(&overlay, cX + offMin, cY + offTwin, len, 1, color);
+}
+
+static const char *const Crosshair[21] = {
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".....................",
+    ".....................",
+    ".....................",
+    "######.........######",
+    ".....................",
+    "######.........######",
+    ".....................",
+    ".....................",
+    ".....................",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+    ".........#.#.........",
+};
+
+// Crosshair and spot temperature composited band by band, 8 rows at a time,
+// like DrawImage does: the bands add up to the whole picture
+static void test_crosshair_in_bands(void) {
+    const int cX = 20, cY = 16;
+    static uint16_t band[8][WIDTH];
+
+    AddCrosshair(cX + 1, cY + 1, SHADOW);
+    Render_OverlayText(&overlay, cX + 9, cY + 9, "12.5", 1, SHADOW);
+    AddCrosshair(cX, cY, INK);
+    Render_OverlayText(&overlay, cX + 8, cY + 8, "12.5", 1, INK);
+
+    for (int top = 0; top < HEIGHT; top += 8) {
+        Render_Target_t part = { &band[0][0], WIDTH, 8, WIDTH };
+        memcpy(band, buf[top], sizeof(band));
+        Render_OverlayComposite(&overlay, &part, 0, top);
+        memcpy(buf[top], band, sizeof(band));
+    }
+
+    Expect(Crosshair, 21, cX + 1 - 10, cY + 1 - 10, 1, SHADOW);
+    Expect(Text125, RENDER_CHAR_HEIGHT, cX + 9, cY + 9, 1, SHADOW);
+    Expect(Crosshair, 21, cX - 10, cY - 10, 1, INK);
+    Expect(Text125, RENDER_CHAR_HEIGHT, cX + 8, cY + 8, 1, INK);
+    CheckPixels();
+
+    int16_t x, y;
+    uint16_t w, h;
+    TEST_ASSERT_TRUE(Render_OverlayBounds(&overlay, &x, &y, &w, &h));
+    TEST_ASSERT_EQUAL_INT16(cX - 10, x);
+    TEST_ASSERT_EQUAL_INT16(cY - 10, y);
+    TEST_ASSERT_EQUAL_UINT16(cX + 9 + 4 * RENDER_CHAR_WIDTH - x, w);
+    TEST_ASSERT_EQUAL_UINT16(cY + 9 + RENDER_CHAR_HEIGHT - y, h);
+}
+
+// Scale label strip of DrawScaleLabels: black digits centred on white
+static void test_scale_label(void) {
+    static const char *const Label35[RENDER_CHAR_HEIGHT] = {
+        "#####.#####.",
+        "...#..#.....",
+        "..#...####..",
+        "...#......#.",
+        "....#.....#.",
+        "#...#.#...#.",
+        ".###...###..",
+        "............",
+    };
+    const int width = 32, height = RENDER_CHAR_HEIGHT * 2;
+    Render_Target_t strip = { &buf[0][0], width, height, width };
+
+    Render_Fill(&strip, INK);
+    Render_OverlayText(&overlay, (width - Render_TextWidth("35", 2)) / 2, 1, "35", 2, SHADOW);
+    Render_OverlayComposite(&overlay, &strip, 0, 0);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int ax = x - 4, ay = y - 1;
+            bool ink = ax >= 0 && ay >= 0 && ay < 2 * RENDER_CHAR_HEIGHT && ax < 24 && Label35[ay / 2][ax / 2] == '#';
+            uint16_t color = ink ? SHADOW : INK;
+            TEST_ASSERT_EQUAL_HEX16(RGB565_SWAP(color), strip.buf[y * width + x]);
+        }
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_is_byte_swapped);
+    RUN_TEST(test_glyphs);
+    RUN_TEST(test_scaled_text_is_clipped);
+    RUN_TEST(test_crosshair_in_bands);
+    RUN_TEST(test_scale_label);
+    return UNITY_END();
+}
@@ -0,0 +1,204 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "render.h"
+#include "palette.h"
+#include "htpa_sim.h"
+
+// Fixed size palette tables and the integer temperature mapping onto them.
+// Range changes only re-initialise the map, nothing is allocated per frame.
+// The tables are checked and timed against color565() on the RGB palette.
+
+static int16_t frame[HTPA_ROWS][HTPA_COLS];
+static HTPA_Stats_t stats;
+static Render_Map_t map;
+static Render_Agc_t agc;
+static Render_Autoscale_t scale;
+static Render_Delta_t delta;
+static int16_t line[RENDER_MAX_WIDTH];
+static uint16_t pixels[RENDER_MAX_WIDTH];
+static uint32_t rng;
+
+void setUp(void) {
+    rng = 1;
+    sim_allocs = 0;
+}
+
+void tearDown(void) {}
+
+// Random scene around ambient with a hot spot, and its statistics
+static void Scene(int16_t ambient, int16_t spot) {
+    memset(&stats, 0, sizeof(stats));
+    stats.minTemp = INT16_MAX;
+    stats.maxTemp = INT16_MIN;
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            rng = rng * 1103515245 + 12345;
+            int16_t t = ambient + (rng >> 16) % 40;
+            if (i >= 12 && i < 16 && j >= 12 && j < 16) t = spot;
+            frame[i][j] = t;
+            if (t < stats.minTemp) stats.minTemp = t;
+            if (t > stats.maxTemp) stats.maxTemp = t;
+            stats.sum += t;
+            int bin = (t - HTPA_HIST_BASE) >> HTPA_HIST_SHIFT;
+            stats.hist[bin < 0 ? 0 : bin >= HTPA_HIST_BINS ? HTPA_HIST_BINS - 1 : bin]++;
+        }
+    }
+    stats.meanTemp = stats.sum / (HTPA_ROWS * HTPA_COLS);
+}
+
+static void test_tables_are_static(void) {
+    const uint16_t *plain = getPaletteTable(PALETTE_IRON, false);
+    const uint16_t *swapped = getPaletteTable(PALETTE_IRON, true);
+
+    TEST_ASSERT_NOT_NULL(plain);
+    TEST_ASSERT_NOT_NULL(swapped);
+    TEST_ASSERT_EQUAL_PTR(plain, getPaletteTable(PALETTE_IRON, false));
+    TEST_ASSERT_EQUAL_PTR(swapped, getPaletteTable(PALETTE_IRON, true));
+    TEST_ASSERT_NULL(getPaletteTable(PALETTE_COUNT, false));
+    for (int i = 0; i < PALETTE_SIZE; i++) TEST_ASSERT_EQUAL_UINT16(RGB565_SWAP(plain[i]), swapped[i]);
+
+    // iron runs from black to white
+    TEST_ASSERT_EQUAL_UINT16(RGB565(0, 0, 0), plain[0]);
+    TEST_ASSERT_EQUAL_UINT16(RGB565(0xFF, 0xFF, 0xFF), plain[PALETTE_SIZE - 1]);
+    TEST_ASSERT_EQUAL_UINT32(0, sim_allocs);
+}
+
+// TFT_eSPI::color565, as the image was coloured before the tables
+static uint16_t Color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+// Every entry is color565() of the RGB palette, byte swapped in the other table
+static void test_tables_match_color565(void) {
+    tRGBcolor *rgb = getPalette(PALETTE_IRON, PALETTE_SIZE);
+    const uint16_t *plain = getPaletteTable(PALETTE_IRON, false);
+    const uint16_t *swapped = getPaletteTable(PALETTE_IRON, true);
+
+    TEST_ASSERT_NOT_NULL(rgb);
+    for (int i = 0; i < PALETTE_SIZE; i++) {
+        uint16_t color = Color565(rgb[i].r, rgb[i].g, rgb[i].b);
+        TEST_ASSERT_EQUAL_HEX16(color, plain[i]);
+        TEST_ASSERT_EQUAL_HEX16(RGB565_SWAP(color), swapped[i]);
+    }
+    freePalette(rgb);
+}
+
+static double Elapsed(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+// Host numbers of colouring a 224x224 image: color565() of the RGB entry per
+// pixel against one load from the swapped table, same pixels either way
+static void test_colorize_throughput(void) {
+    static uint16_t reference[RENDER_MAX_WIDTH];
+    const int rows = 224, width = 224, frames = 200;
+    struct timespec start;
+    tRGBcolor *rgb = getPalette(PALETTE_IRON, PALETTE_SIZE);
+
+    TEST_ASSERT_NOT_NULL(rgb);
+    Scene(2950, 3300);
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, stats.minTemp, stats.maxTemp);
+    for (int x = 0; x < width; x++) line[x] = frame[x / 7][x % HTPA_COLS];
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames * rows; n++) {
+        for (int x = 0; x < width; x++) {
+            const tRGBcolor *c = &rgb[Render_MapIndex(&map, line[x])];
+            reference[x] = RGB565_SWAP(Color565(c->r, c->g, c->b));
+        }
+        __asm__ volatile("" : : "r"(reference) : "memory");
+    }
+    double rgb_us = Elapsed(&start) / frames;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames * rows; n++) {
+        Render_Colorize(line, pixels, width, &map);
+        __asm__ volatile("" : : "r"(pixels) : "memory");
+    }
+    double table_us = Elapsed(&start) / frames;
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "224x224 frame: color565 %.1f us, RGB565 table %.1f us", rgb_us, table_us);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(reference, pixels, width);
+    TEST_ASSERT_TRUE(rgb_us > 0 && table_us > 0);
+    freePalette(rgb);
+}
+
+// Linear map: ends clamp, indices grow with temperature and stay within one
+// entry of the exact proportion
+static void test_linear_map(void) {
+    const int16_t ranges[][2] = { { 2932, 3332 }, { 2732, 2742 }, { 2500, 4500 } };
+
+    for (size_t n = 0; n < sizeof(ranges) / sizeof(ranges[0]); n++) {
+        const int16_t lo = ranges[n][0], hi = ranges[n][1];
+        Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, lo, hi);
+        TEST_ASSERT_EQUAL_UINT16(0, Render_MapIndex(&map, lo - 100));
+        TEST_ASSERT_EQUAL_UINT16(0, Render_MapIndex(&map, lo));
+        TEST_ASSERT_EQUAL_UINT16(PALETTE_SIZE - 1, Render_MapIndex(&map, hi));
+        TEST_ASSERT_EQUAL_UINT16(PALETTE_SIZE - 1, Render_MapIndex(&map, hi + 100));
+
+        uint16_t last = 0;
+        for (int16_t t = lo; t < hi; t++) {
+            uint16_t idx = Render_MapIndex(&map, t);
+            TEST_ASSERT_TRUE(idx >= last && idx < PALETTE_SIZE);
+            TEST_ASSERT_INT_WITHIN(1, (t - lo) * PALETTE_SIZE / (hi - lo), idx);
+            last = idx;
+        }
+    }
+
+    // an empty range still splits at the single temperature
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 3000, 3000);
+    TEST_ASSERT_EQUAL_UINT16(0, Render_MapIndex(&map, 3000));
+    TEST_ASSERT_EQUAL_UINT16(PALETTE_SIZE - 1, Render_MapIndex(&map, 3001));
+}
+
+// A new range is a different map, the delta tracker redraws everything
+static void test_range_change_redraws_all_tiles(void) {
+    Scene(2950, 3300);
+    Render_DeltaInit(&delta, 0, 1);
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 2932, 3332);
+    TEST_ASSERT_EQUAL_UINT16(HTPA_ROWS * HTPA_COLS, Render_DeltaUpdate(&delta, frame, true, &map, false));
+    TEST_ASSERT_EQUAL_UINT16(0, Render_DeltaUpdate(&delta, frame, true, &map, false));
+
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 2940, 3332);
+    TEST_ASSERT_EQUAL_UINT16(HTPA_ROWS * HTPA_COLS, Render_DeltaUpdate(&delta, frame, true, &map, false));
+}
+
+// Autoscale, AGC, range changes and colourising frame after frame
+static void test_no_allocation_per_frame(void) {
+    int16_t minTemp, maxTemp;
+
+    Render_AutoscaleInit(&scale, 4, 64, 16, 10, 20);
+    Render_AgcInit(&agc, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 16, 32, 2);
+    Render_DeltaInit(&delta, 1, 2);
+    sim_allocs = 0;
+
+    for (int n = 0; n < 10000; n++) {
+        Scene(2900 + n % 300, 3100 + n % 500);
+        Render_AutoscaleUpdate(&scale, &stats, &minTemp, &maxTemp);
+        Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, minTemp, maxTemp);
+        if (n & 1) Render_AgcUpdate(&agc, &stats, &map);
+        Render_DeltaUpdate(&delta, frame, true, &map, false);
+        for (int i = 0; i < HTPA_ROWS; i++) {
+            for (int j = 0; j < HTPA_COLS; j++) line[j] = frame[i][j];
+            Render_Colorize(line, pixels, HTPA_COLS, &map);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sim_allocs);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tables_are_static);
+    RUN_TEST(test_tables_match_color565);
+    RUN_TEST(test_colorize_throughput);
+    RUN_TEST(test_linear_map);
+    RUN_TEST(test_range_change_redraws_all_tiles);
+    RUN_TEST(test_no_allocation_per_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,217 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+
+// Block readout on the simulated bus: pipelined against serial readout, the
+// end of conversion wait learning the conversion time, and the transactions
+// batched into command links.
+
+#define FRAMES      20
+
+typedef struct {
+    uint64_t us;                    // virtual time of FRAMES captures
+    uint32_t overlapped;
+    uint32_t conversions;
+    uint16_t pixelData[FRAMES][HTPA_ROWS][HTPA_COLS];
+    int16_t pixelTemps[FRAMES][HTPA_ROWS][HTPA_COLS];
+} Run_t;
+
+static HTPA_Data_t data;
+static HTPA_EEPROM_Data_t eeprom;
+static Run_t serial, pipelined;
+
+static void Reset(void) {
+    HTPA_SimReset(114);
+    sim_signal = 2000;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+}
+
+void setUp(void) {
+    Reset();
+    HTPA_SetFilter(false);
+    HTPA_SetOversampling(1);
+}
+
+void tearDown(void) {
+    HTPA_SetPipelined(HTPA_PIPELINED_DEFAULT);
+}
+
+static void Capture(Run_t *run, bool pipeline) {
+    HTPA_SetPipelined(pipeline);
+    // first frame learns the conversion time
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    uint64_t start = sim_us;
+    uint32_t overlapped = sim_overlapped, conversions = sim_conversions;
+
+    for (int n = 0; n < FRAMES; n++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+        memcpy(run->pixelData[n], data.pixelData, sizeof(data.pixelData));
+        memcpy(run->pixelTemps[n], data.pixelTemps, sizeof(data.pixelTemps));
+    }
+    run->us = sim_us - start;
+    run->overlapped = sim_overlapped - overlapped;
+    run->conversions = sim_conversions - conversions;
+}
+
+// Serial readout starts a conversion only after both halves of the last block
+// were read, pipelined readout before reading them
+static void test_pipelining_overlaps_conversion_and_readout(void) {
+    Capture(&serial, false);
+    Reset();
+    Capture(&pipelined, true);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%d frames: serial %llu us, pipelined %llu us, %u of %u conversions overlapped",
+             FRAMES, (unsigned long long)serial.us, (unsigned long long)pipelined.us,
+             pipelined.overlapped, pipelined.conversions);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_UINT32(0, serial.overlapped);
+    TEST_ASSERT_EQUAL_UINT32(serial.conversions, pipelined.conversions);
+    // all blocks but the first of a frame
+    TEST_ASSERT_GREATER_OR_EQUAL(FRAMES * (HTPA_BLOCKS - 1), pipelined.overlapped);
+    // at least the readout of three blocks per frame is hidden
+    TEST_ASSERT_TRUE_MESSAGE(pipelined.us + FRAMES * 3 * 2 * 258 * 10ULL < serial.us, msg);
+}
+
+// Same scene, same frames
+static void test_pipelining_keeps_the_data(void) {
+    Capture(&serial, false);
+    Reset();
+    Capture(&pipelined, true);
+
+    TEST_ASSERT_EQUAL_MEMORY(serial.pixelData, pipelined.pixelData, sizeof(serial.pixelData));
+    TEST_ASSERT_EQUAL_MEMORY(serial.pixelTemps, pipelined.pixelTemps, sizeof(serial.pixelTemps));
+}
+
+// Status polls of one capture, and no block read before its end of conversion
+static uint32_t CapturePolls(void) {
+    uint32_t polls = sim_status_polls;
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL_UINT32(0, sim_early_reads);
+    return sim_status_polls - polls;
+}
+
+// Learned by an EMA, polled for only around the expected end of conversion
+static uint32_t LearnConversion(uint32_t conv_us, uint32_t *first) {
+    char msg[96];
+    uint32_t polls = 0;
+
+    sim_conv_us = conv_us;
+    *first = CapturePolls();
+    for (int n = 0; n < 10; n++) polls = CapturePolls();
+
+    const HTPA_Frame_t *frame = HTPA_GetLatestFrame();
+    TEST_ASSERT_NOT_NULL(frame);
+    snprintf(msg, sizeof(msg), "%u us conversion: %u polls first frame, %u converged, learned %u us",
+             conv_us, *first, polls, frame->timing.conv_time_us);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_UINT32_WITHIN_MESSAGE(conv_us / 50, conv_us, frame->timing.conv_time_us, msg);
+    TEST_ASSERT_GREATER_THAN_MESSAGE(0, frame->timing.sleep_us, msg);
+    return polls;
+}
+
+static void test_eoc_polls_drop_once_learned(void) {
+    // new trim settings, the conversion time is learned from scratch
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_LoadCalibration(&eeprom, true));
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_LoadCalibration(&eeprom, false));
+
+    uint32_t cold;
+    uint32_t polls = LearnConversion(25000, &cold);
+    TEST_ASSERT_LESS_THAN(cold / 10, polls);
+    // a few polls per block and blind frame around the guard time
+    TEST_ASSERT_LESS_OR_EQUAL((HTPA_BLOCKS + 1) * (HTPA_EOC_GUARD_US / HTPA_EOC_POLL_US + 2), polls);
+}
+
+// A slower conversion wakes up early and polls until the real end of
+// conversion, then the longer time is learned
+static void test_eoc_relearns_a_slower_conversion(void) {
+    uint32_t first, polls;
+
+    LearnConversion(25000, &first);
+    polls = LearnConversion(35000, &first);
+    TEST_ASSERT_GREATER_THAN(10 * polls, first);
+}
+
+// Without end of conversion nothing is read and the capture fails
+static void test_eoc_timeout_fails_the_capture(void) {
+    CapturePolls();
+    CapturePolls();
+    TEST_ASSERT_NOT_NULL(HTPA_GetLatestFrame());
+
+    sim_conv_us = 2000000;
+    TEST_ASSERT_EQUAL(HTPA_ERR, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL_UINT32(0, sim_early_reads);
+    TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+}
+
+typedef struct {
+    uint32_t links;                 // command links, without status polls
+    uint32_t transactions;          // reads and writes, without status polls
+    uint32_t blind;
+} Bus_t;
+
+static Bus_t CaptureBus(void) {
+    uint32_t batches = sim_batches, reads = sim_reads, writes = sim_writes;
+    uint32_t polls = sim_status_polls, blind = sim_blind_conversions;
+
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    polls = sim_status_polls - polls;
+    return (Bus_t){ sim_batches - batches - polls, sim_reads - reads + sim_writes - writes - polls,
+                    sim_blind_conversions - blind };
+}
+
+// Unbatched every transaction is a command link of its own. A frame starts
+// block 0 and reads each block in one link together with the start of the
+// next, a blind frame adds one link reading both halves.
+static void test_frame_transactions_are_batched(void) {
+    bool seen[2] = { false, false };
+
+    for (int n = 0; n < 30; n++) {
+        Bus_t bus = CaptureBus();
+        if (n < 2) continue;        // VDD and first offsets
+        char msg[96];
+        snprintf(msg, sizeof(msg), "frame %d: %u transactions in %u links, %u blind", n, bus.transactions, bus.links, bus.blind);
+        TEST_ASSERT_TRUE_MESSAGE(bus.blind <= 1, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(3 * HTPA_BLOCKS + 3 * bus.blind, bus.transactions, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(HTPA_BLOCKS + 1 + bus.blind, bus.links, msg);
+        if (!seen[bus.blind]) TEST_MESSAGE(msg);
+        seen[bus.blind] = true;
+    }
+    TEST_ASSERT_TRUE(seen[0] && seen[1]);
+}
+
+// A transaction not acknowledged in the middle of a batch fails the capture,
+// nothing is published from half read buffers
+static void test_nack_mid_batch_fails_the_capture(void) {
+    const uint8_t regs[] = { HTPA_READ_TOP, HTPA_READ_BOTTOM, HTPA_CONFIG_REG };
+
+    for (size_t n = 0; n < sizeof(regs); n++) {
+        CaptureBus();
+        CaptureBus();
+        TEST_ASSERT_NOT_NULL(HTPA_GetLatestFrame());
+
+        sim_nack_reg = regs[n];
+        TEST_ASSERT_EQUAL(HTPA_ERR, HTPA_CaptureData(&data, &eeprom));
+        TEST_ASSERT_EQUAL_INT(-1, sim_nack_reg);
+        TEST_ASSERT_NULL(HTPA_GetLatestFrame());
+        TEST_ASSERT_EQUAL_UINT32(0, sim_early_reads);
+    }
+    // and the next capture recovers
+    CaptureBus();
+    TEST_ASSERT_NOT_NULL(HTPA_GetLatestFrame());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_pipelining_overlaps_conversion_and_readout);
+    RUN_TEST(test_pipelining_keeps_the_data);
+    RUN_TEST(test_eoc_polls_drop_once_learned);
+    RUN_TEST(test_eoc_relearns_a_slower_conversion);
+    RUN_TEST(test_eoc_timeout_fails_the_capture);
+    RUN_TEST(test_frame_transactions_are_batched);
+    RUN_TEST(test_nack_mid_batch_fails_the_capture);
+    return UNITY_END();
+}
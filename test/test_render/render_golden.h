@@ -0,0 +1,103 @@
+#ifndef _RENDER_GOLDEN_H_
+#define _RENDER_GOLDEN_H_
+
+#include <stdint.h>
+#include "render.h"
+
+// Row hashes of the 224x224 test image per engine, printed by test_main.c
+// built with -DRENDER_PRINT_GOLDEN (IRON palette, 2832 to 3182 dK)
+
+static const uint32_t RenderGoldenRows[RENDER_ENGINE_COUNT][224] = {
+    {  // nearest
+        0x3AD10045, 0x3AD10045, 0x3AD10045, 0x3AD10045, 0x3AD10045, 0x3AD10045, 0x3AD10045, 0xA5B67C22,
+        0xA5B67C22, 0xA5B67C22, 0xA5B67C22, 0xA5B67C22, 0xA5B67C22, 0xA5B67C22, 0x7846967F, 0x7846967F,
+        0x7846967F, 0x7846967F, 0x7846967F, 0x7846967F, 0x7846967F, 0xE82FEE7A, 0xE82FEE7A, 0xE82FEE7A,
+        0xE82FEE7A, 0xE82FEE7A, 0xE82FEE7A, 0xE82FEE7A, 0x8A0AA968, 0x8A0AA968, 0x8A0AA968, 0x8A0AA968,
+        0x8A0AA968, 0x8A0AA968, 0x8A0AA968, 0xFDACBA40, 0xFDACBA40, 0xFDACBA40, 0xFDACBA40, 0xFDACBA40,
+        0xFDACBA40, 0xFDACBA40, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5,
+        0x8840D8A5, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D,
+        0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0xBC3DA1EC,
+        0xBC3DA1EC, 0xBC3DA1EC, 0xBC3DA1EC, 0xBC3DA1EC, 0xBC3DA1EC, 0xBC3DA1EC, 0xB2339CA2, 0xB2339CA2,
+        0xB2339CA2, 0xB2339CA2, 0xB2339CA2, 0xB2339CA2, 0xB2339CA2, 0x1536447D, 0x1536447D, 0x1536447D,
+        0x1536447D, 0x1536447D, 0x1536447D, 0x1536447D, 0xB7C7BAF6, 0xB7C7BAF6, 0xB7C7BAF6, 0xB7C7BAF6,
+        0xB7C7BAF6, 0xB7C7BAF6, 0xB7C7BAF6, 0xF5157B51, 0xF5157B51, 0xF5157B51, 0xF5157B51, 0xF5157B51,
+        0xF5157B51, 0xF5157B51, 0x8522402E, 0x8522402E, 0x8522402E, 0x8522402E, 0x8522402E, 0x8522402E,
+        0x8522402E, 0x1EF5D502, 0x1EF5D502, 0x1EF5D502, 0x1EF5D502, 0x1EF5D502, 0x1EF5D502, 0x1EF5D502,
+        0x8AA9CB5C, 0x8AA9CB5C, 0x8AA9CB5C, 0x8AA9CB5C, 0x8AA9CB5C, 0x8AA9CB5C, 0x8AA9CB5C, 0x05792122,
+        0x05792122, 0x05792122, 0x05792122, 0x05792122, 0x05792122, 0x05792122, 0xC41905EB, 0xC41905EB,
+        0xC41905EB, 0xC41905EB, 0xC41905EB, 0xC41905EB, 0xC41905EB, 0x2DC6E0C4, 0x2DC6E0C4, 0x2DC6E0C4,
+        0x2DC6E0C4, 0x2DC6E0C4, 0x2DC6E0C4, 0x2DC6E0C4, 0xDC9E80B5, 0xDC9E80B5, 0xDC9E80B5, 0xDC9E80B5,
+        0xDC9E80B5, 0xDC9E80B5, 0xDC9E80B5, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D,
+        0x85FB3C7D, 0x85FB3C7D, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5,
+        0x13CCA0F5, 0x4AD4D7AD, 0x4AD4D7AD, 0x4AD4D7AD, 0x4AD4D7AD, 0x4AD4D7AD, 0x4AD4D7AD, 0x4AD4D7AD,
+        0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x8840D8A5, 0x7FD03F8D,
+        0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x7FD03F8D, 0x2F69B99D, 0x2F69B99D,
+        0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x2F69B99D, 0x324B53FD, 0x324B53FD, 0x324B53FD,
+        0x324B53FD, 0x324B53FD, 0x324B53FD, 0x324B53FD, 0xC770F7BD, 0xC770F7BD, 0xC770F7BD, 0xC770F7BD,
+        0xC770F7BD, 0xC770F7BD, 0xC770F7BD, 0xDC9E80B5, 0xDC9E80B5, 0xDC9E80B5, 0xDC9E80B5, 0xDC9E80B5,
+        0xDC9E80B5, 0xDC9E80B5, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D, 0x85FB3C7D,
+        0x85FB3C7D, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5, 0x13CCA0F5,
+    },
+    {  // bilinear
+        0xACF7C8C4, 0x66520B38, 0xFC522219, 0xA42A8C26, 0x3A3A3A49, 0xC2A97028, 0x799640C4, 0x32316BEF,
+        0xC8DBF9F8, 0xE974C2FB, 0xEB44559A, 0xF4EF7B7F, 0x19DD701C, 0x5DE3A831, 0xBF999100, 0x627D50A5,
+        0xFAD26488, 0x58B01F7B, 0x6E2D9C5B, 0xA50459DA, 0x6A4C9C6F, 0xC71D2ACF, 0x13217C73, 0x81673C3B,
+        0x601A5A49, 0x8AF5426F, 0xD9208EE7, 0xA2D674D5, 0x3AB48F30, 0x6E4B80A0, 0x5D462EE4, 0x0DDEDC3A,
+        0x94A5DD1A, 0xEDB48474, 0x33572A4F, 0x31080A8F, 0x332C196F, 0xB96F1413, 0x6A360555, 0x94BD8362,
+        0xF073BBB2, 0xB9FC7745, 0x1CAF748D, 0x357E4145, 0x357E4145, 0xE0B591FD, 0x03E38F6D, 0xF98978C5,
+        0xB043118D, 0x6BEB8655, 0x4B0FCC05, 0x4321FFED, 0x7452F955, 0x31550465, 0x890226ED, 0xD67D70B5,
+        0x2A8381A5, 0x9DF1CE68, 0xAC724593, 0xD4D94260, 0xC979E40D, 0x6DE0AA03, 0xCADEC78C, 0xF4F62A77,
+        0xA3EA65C8, 0xE801046F, 0xE3467954, 0x1E8095DB, 0xC737BFB7, 0xF216321E, 0x9242F16F, 0xB5B16AF6,
+        0xEFAF4CC4, 0x03292738, 0xCA5D74CA, 0xD903ED36, 0x76F837BC, 0x59DD96B4, 0x62289E79, 0xC313F10C,
+        0x0030B30D, 0x20E10FA9, 0x5E0D321E, 0xF0E894EE, 0x7A637A68, 0x1D9DF927, 0x6F3D29CC, 0xBFCFD57A,
+        0xB391B4AF, 0x07B66452, 0x445F6A0C, 0x1E2EA5BB, 0x43246781, 0xE0D03212, 0xA0D94DDA, 0x39AC2E2B,
+        0x830FA3B8, 0x41E57456, 0x61CF6F54, 0xE90349F5, 0x6C4EB942, 0xE26255A1, 0x6CF49D41, 0xB2F0E75F,
+        0x316C7E40, 0xD21A37DB, 0x88735FBB, 0x50EFCC8E, 0xF289B44E, 0x6DC306B9, 0x56866A48, 0xB3D2FDA0,
+        0x24125318, 0xFE2F0A1F, 0x8219DF2B, 0x58207655, 0xEAB18DB5, 0x226BD07A, 0xCD6E6AEF, 0x750E6E9D,
+        0x19D77C80, 0x48151B53, 0x1F5ABBCF, 0x5A5D5D00, 0xEC870502, 0xFC343FF3, 0xB23E8144, 0xE43BCEAD,
+        0x52CA5FEB, 0x79E1FBAB, 0xF562F706, 0x0416F76F, 0x4EBBEAB2, 0x4F5D5BE0, 0x975A6074, 0xAD7AF345,
+        0x9E9B34D7, 0xE6472FB8, 0x31624C3A, 0x9F8D77BD, 0x5E4AFCC5, 0x1DD37AC5, 0x7A43DA5D, 0x7A43DA5D,
+        0x6BEB8655, 0x0D87853D, 0xBC67D44D, 0x50752D55, 0x8B6A9A5D, 0x8B6A9A5D, 0x15DD0735, 0xD027449D,
+        0xBE92DF9D, 0x4E1F22F5, 0x9BA82445, 0x5210B7F5, 0x2AE40045, 0xAC9E54F5, 0x6DA8F2C5, 0x80216365,
+        0x70D5D775, 0x8E04C91D, 0x373D7A65, 0xAFB2E695, 0xAFB2E695, 0xB3F37DBD, 0x8100BB6D, 0x95346645,
+        0x1CAF748D, 0x357E4145, 0x357E4145, 0xE0B591FD, 0x03E38F6D, 0xF98978C5, 0xB043118D, 0x6BEB8655,
+        0x4B0FCC05, 0x4321FFED, 0x7452F955, 0x31550465, 0x890226ED, 0xD67D70B5, 0x2A8381A5, 0x5C89119D,
+        0xF1F0EE25, 0xF1F0EE25, 0x9BA82445, 0x4099FBF5, 0x1DD30A1D, 0xBCA2A1B5, 0x7E358085, 0x7E358085,
+        0x7F4C3285, 0x1CDFA7F5, 0xD17AF3B5, 0xEC099B6D, 0xB3F37DBD, 0xF6663665, 0x38562EB5, 0xD7575A15,
+        0xE4C734B5, 0xAE6724C5, 0xCD2213B5, 0x5E4AFCC5, 0x1DD37AC5, 0x7A43DA5D, 0x7A43DA5D, 0x6BEB8655,
+        0x0D87853D, 0xBC67D44D, 0x50752D55, 0x8B6A9A5D, 0x8B6A9A5D, 0x15DD0735, 0xD027449D, 0xBE92DF9D,
+        0x4E1F22F5, 0x9BA82445, 0x9BA82445, 0x9BA82445, 0x9BA82445, 0x9BA82445, 0x9BA82445, 0x9BA82445,
+    },
+    {  // bicubic
+        0x3B692E9A, 0x0C956365, 0x4692DD55, 0xF5F2D668, 0xE962C4BC, 0x430B2FA7, 0xC8CE5E0F, 0x9735B335,
+        0x0D9791AE, 0xDB325299, 0x1091E11E, 0xF9B68D38, 0x082AF382, 0x39644D6F, 0xC734556C, 0x0777D788,
+        0xB08F1400, 0x44A9CAAD, 0x1706B5AA, 0x4C87AA43, 0xCBF8A323, 0x10F924B2, 0x70227E9E, 0xBF4C8EAE,
+        0x75E80F99, 0x95446364, 0xB18EB64F, 0xFFF225B9, 0x388D7448, 0xF06090A0, 0x024CF509, 0xE21B08D2,
+        0x1557BD3D, 0x95C9B3E3, 0xC5788A38, 0xC95679B3, 0xD7A57E53, 0x5D38B951, 0x1901D0C2, 0x7F3C179D,
+        0x48089255, 0x6D1CBAB5, 0x3776D10D, 0xB55E8E4D, 0xD8024855, 0x9D2FA195, 0x5EB72E5D, 0x14C08AF5,
+        0xDD71EAA5, 0x9C88F8BD, 0x3212465D, 0x910FB39D, 0xDE435B15, 0x1C6CB875, 0x7D581D85, 0x830CAA15,
+        0x46624F9D, 0x5C119F95, 0x9824E710, 0x890A0D69, 0x249DF604, 0x50349418, 0x53FC9DB3, 0x2CCA74BE,
+        0x9BC79197, 0xCE389632, 0x77674ECE, 0xC8BA4051, 0xBD39567A, 0xC62DC35E, 0xB27BD67D, 0x7CB193B8,
+        0xC32F2AB0, 0x84373736, 0xDA012725, 0x3DB8CC09, 0x96E4C18B, 0xCEC8F319, 0xF307A1D5, 0x68AFEA51,
+        0xF84FF93C, 0x72F56EF1, 0x9C7E34F0, 0x84C56498, 0xA319EFD2, 0x6DF7CF03, 0xE77D9609, 0x22E54330,
+        0x9FFA7FBE, 0x76B2E0AE, 0xA1267616, 0x93B3DA82, 0xF0F81D55, 0x6E80E139, 0xB4A07896, 0x8E4E3339,
+        0x79143812, 0x83F0DBC4, 0xC445CC10, 0x2219BAF7, 0x75A10975, 0x2196FBC5, 0x2B1A866F, 0x2FF2839E,
+        0x124934A2, 0xDE084F50, 0xCBD6F909, 0x5DBB7763, 0xE2B9BB40, 0xE4AD9349, 0x3A931E8F, 0xB879222A,
+        0x6F9DC5AA, 0x6118BAFB, 0xF2F919CC, 0xC38A2039, 0x51EFE1D2, 0x278E7AAC, 0x90CC72ED, 0x4478D6BA,
+        0xB6746007, 0x1A932695, 0xB6576E86, 0xC513785A, 0x348BBE30, 0xAD4CF7DA, 0xE98F0CA8, 0xA66D2A6D,
+        0xEDE5AB28, 0xE637ED6B, 0x7A71EF84, 0x117EDA98, 0xF35C60C0, 0x4897673A, 0x61213A18, 0xC7EEE7A1,
+        0xCFE7FF08, 0xF4606D04, 0xE335B4D2, 0xA5D9A015, 0x1DD37AC5, 0xE7E2C795, 0xB593077A, 0xB8BC8F12,
+        0x872ED57D, 0xE4E972DD, 0x9140CE9D, 0xF7F07455, 0x53E960C5, 0xB4915CED, 0x15DD0735, 0x6036E79D,
+        0xBE92DF9D, 0x4E1F22F5, 0xF1F0EE25, 0x5210B7F5, 0x9BE3DDF5, 0xA702AC25, 0x04811A5D, 0x80216365,
+        0x36F5F50D, 0xDFF0F71D, 0xD3FE5B7D, 0xEBA24C45, 0xAFB2E695, 0xB7F163FD, 0x1DD31205, 0xFFAE7B3D,
+        0x3776D10D, 0x1B08B425, 0x8FD0F5B5, 0xE0B591FD, 0x21146D1D, 0xF98978C5, 0xB043118D, 0x9C88F8BD,
+        0x4B0FCC05, 0x9ED5773D, 0x2426760D, 0x31550465, 0x890226ED, 0xD67D70B5, 0x46624F9D, 0x5C89119D,
+        0xF1F0EE25, 0x6F27BC4D, 0x9F6454E5, 0x73C95805, 0xF76AD935, 0xF76AD935, 0x099F6515, 0x8EA194F5,
+        0x7F4C3285, 0x58364EF5, 0xD17AF3B5, 0xEC099B6D, 0xA501B59D, 0xF6663665, 0x5605E465, 0xB965B145,
+        0xE4C734B5, 0xAE6724C5, 0xCD2213B5, 0x1DD37AC5, 0x93C76575, 0x7A43DA5D, 0x7A43DA5D, 0xE7B7F705,
+        0x91CB7DD5, 0xAD4D173D, 0xF7F07455, 0x53E960C5, 0xB4915CED, 0x15DD0735, 0x7F47319D, 0xB8E81C45,
+        0x4E1F22F5, 0xF1F0EE25, 0x5210B7F5, 0x5210B7F5, 0x5210B7F5, 0x5210B7F5, 0x5210B7F5, 0xF1F0EE25,
+    },
+};
+
+#endif
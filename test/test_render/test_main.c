@@ -0,0 +1,121 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "render.h"
+#include "palette.h"
+#include "render_golden.h"
+
+// Rendering into a memory target as the image paths do, upscaled rows
+// coloured straight into the buffer: a golden image per engine, kept as a
+// hash of every row, and the throughput. Build with -DRENDER_PRINT_GOLDEN to
+// print render_golden.h after an intended change of the scaler or palette.
+
+#define WIDTH       224
+#define HEIGHT      224
+#define STRIDE      240         // wider than the image, the rest is not touched
+#define PADDING     0xA5A5
+
+static int16_t frame[HTPA_ROWS][HTPA_COLS];
+static uint16_t buf[HEIGHT][STRIDE];
+static Render_Target_t target = { &buf[0][0], WIDTH, HEIGHT, STRIDE };
+static Render_Layout_t layout;
+static Render_Scaler_t scaler;
+static Render_Map_t map;
+static int16_t line[RENDER_MAX_WIDTH];
+
+void setUp(void) {
+    // room background with a warm object and a cold corner
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            int16_t t = 2952 + (i * 7 + j * 3) % 9;
+            if (i >= 9 && i < 20 && j >= 11 && j < 22) t = 3082 + (i - 9) * 9 + (j - 11) * 4;
+            if (i < 6 && j < 6) t = 2832 + i * 5 + j * 3;
+            frame[i][j] = t;
+        }
+    }
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 2832, 3182);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < STRIDE; x++) buf[y][x] = PADDING;
+    }
+}
+
+void tearDown(void) {}
+
+static void Render(void) {
+    Render_ScalerBegin(&scaler, &layout, frame);
+    for (uint16_t y = 0; y < target.height; y++) {
+        Render_ScalerRow(&scaler, y, 0, target.width, line);
+        Render_Colorize(line, Render_TargetRow(&target, y), target.width, &map);
+    }
+}
+
+// FNV-1a of the pixels of one row
+static uint32_t RowHash(const uint16_t *row, uint16_t width) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t x = 0; x < width; x++) {
+        hash = (hash ^ (row[x] & 0xFF)) * 16777619u;
+        hash = (hash ^ (row[x] >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+static void test_golden_images(void) {
+#ifdef RENDER_PRINT_GOLDEN
+    printf("static const uint32_t RenderGoldenRows[RENDER_ENGINE_COUNT][%u] = {\n", HEIGHT);
+#endif
+    for (uint8_t engine = 0; engine < RENDER_ENGINE_COUNT; engine++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, engine, WIDTH, HEIGHT, true));
+        Render();
+#ifdef RENDER_PRINT_GOLDEN
+        printf("    {  // %s", Render_Engines[engine].name);
+        for (int y = 0; y < HEIGHT; y++) printf("%s0x%08X,", y % 8 ? " " : "\n        ", RowHash(buf[y], WIDTH));
+        printf("\n    },\n");
+#else
+        for (int y = 0; y < HEIGHT; y++) {
+            char msg[48];
+            snprintf(msg, sizeof(msg), "%s, row %d", Render_Engines[engine].name, y);
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(RenderGoldenRows[engine][y], RowHash(buf[y], WIDTH), msg);
+            for (int x = WIDTH; x < STRIDE; x++) TEST_ASSERT_EQUAL_HEX16_MESSAGE(PADDING, buf[y][x], msg);
+        }
+#endif
+    }
+#ifdef RENDER_PRINT_GOLDEN
+    printf("};\n\n");
+#endif
+}
+
+static double Elapsed(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+// Host numbers of a whole 224x224 image into memory, per engine
+static void test_render_throughput(void) {
+    const int frames = 200;
+    struct timespec start;
+
+    for (uint8_t engine = 0; engine < RENDER_ENGINE_COUNT; engine++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, engine, WIDTH, HEIGHT, true));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int n = 0; n < frames; n++) {
+            Render();
+            __asm__ volatile("" : : "r"(buf) : "memory");
+        }
+        double us = Elapsed(&start) / frames;
+
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%-8s %ux%u frame: %.1f us, %.1f Mpixel/s",
+                 Render_Engines[engine].name, WIDTH, HEIGHT, us, WIDTH * HEIGHT / us);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(us > 0);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_golden_images);
+    RUN_TEST(test_render_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,296 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "render.h"
+
+// The separable upscaler against the float bilinear blend it replaced and a
+// float Catmull-Rom: output pixel x samples u = x * 32 / width, blends the
+// cells around floor(u) (clamped at the edge) by the fraction of u, columns
+// mirrored. Benchmarked per engine at the layouts of main.cpp.
+
+static int16_t frame[HTPA_ROWS][HTPA_COLS];
+// SetRenderLayout choices in main.cpp
+static const uint16_t layouts[][2] = { { 224, 224 }, { 226, 226 }, { 264, 198 } };
+#define LAYOUT_COUNT    (sizeof(layouts) / sizeof(layouts[0]))
+
+static Render_Layout_t layout;
+static Render_Scaler_t scaler;
+static int16_t out[RENDER_MAX_WIDTH];
+static uint32_t rng;
+
+void setUp(void) {
+    rng = 1;
+}
+
+void tearDown(void) {}
+
+static void RandomFrame(uint16_t span) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            rng = rng * 1103515245 + 12345;
+            frame[i][j] = 2732 + (rng >> 16) % span;
+        }
+    }
+}
+
+static double FloatBilinear(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    double u = (double)x * HTPA_COLS / width, v = (double)y * HTPA_ROWS / height;
+    int baseCol = (int)u, baseRow = (int)v;
+    int nextCol = baseCol + 1 < HTPA_COLS ? baseCol + 1 : baseCol;
+    int nextRow = baseRow + 1 < HTPA_ROWS ? baseRow + 1 : baseRow;
+    double fx = u - baseCol, fy = v - baseRow;
+
+    double t1 = frame[baseRow][HTPA_COLS - baseCol - 1];
+    double t2 = frame[baseRow][HTPA_COLS - nextCol - 1];
+    double t3 = frame[nextRow][HTPA_COLS - baseCol - 1];
+    double t4 = frame[nextRow][HTPA_COLS - nextCol - 1];
+    return t1 * (1 - fx) * (1 - fy) + t2 * fx * (1 - fy) + t3 * (1 - fx) * fy + t4 * fx * fy;
+}
+
+// Largest difference to the float blend over the whole image
+static double CompareBilinear(uint16_t width, uint16_t height, bool rounded) {
+    double worst = 0;
+
+    TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, RENDER_ENGINE_BILINEAR, width, height, true));
+    Render_ScalerBegin(&scaler, &layout, frame);
+    for (uint16_t y = 0; y < height; y++) {
+        Render_ScalerRow(&scaler, y, 0, width, out);
+        for (uint16_t x = 0; x < width; x++) {
+            double ref = FloatBilinear(x, y, width, height);
+            if (rounded) ref = floor(ref + 0.5);
+            double d = fabs(out[x] - ref);
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+static double CatmullRom(double x) {
+    x = fabs(x);
+    if (x < 1) return 1.5 * x * x * x - 2.5 * x * x + 1;
+    if (x < 2) return -0.5 * x * x * x + 2.5 * x * x - 4 * x + 2;
+    return 0;
+}
+
+static int Clamp(int c, int cells) {
+    return c < 0 ? 0 : c >= cells ? cells - 1 : c;
+}
+
+static double FloatBicubic(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    double u = (double)x * HTPA_COLS / width, v = (double)y * HTPA_ROWS / height;
+    int baseCol = (int)u, baseRow = (int)v;
+    double sum = 0;
+
+    for (int r = baseRow - 1; r <= baseRow + 2; r++) {
+        for (int c = baseCol - 1; c <= baseCol + 2; c++) {
+            double t = frame[Clamp(r, HTPA_ROWS)][HTPA_COLS - Clamp(c, HTPA_COLS) - 1];
+            sum += t * CatmullRom(u - c) * CatmullRom(v - r);
+        }
+    }
+    return sum;
+}
+
+// Largest difference to the float Catmull-Rom
+static double CompareBicubic(uint16_t width, uint16_t height) {
+    double worst = 0;
+
+    TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, RENDER_ENGINE_BICUBIC, width, height, true));
+    Render_ScalerBegin(&scaler, &layout, frame);
+    for (uint16_t y = 0; y < height; y++) {
+        Render_ScalerRow(&scaler, y, 0, width, out);
+        for (uint16_t x = 0; x < width; x++) {
+            double d = fabs(out[x] - FloatBicubic(x, y, width, height));
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+// Phases in quarters and eighths are exact Q8 weights, the output is the
+// rounded float blend bit for bit
+static void test_bilinear_bit_exact_for_dyadic_phases(void) {
+    RandomFrame(600);
+    TEST_ASSERT_EQUAL_INT(0, (int)CompareBilinear(256, 128, true));
+    TEST_ASSERT_EQUAL_INT(0, (int)CompareBilinear(128, 64, true));
+    TEST_ASSERT_EQUAL_INT(0, (int)CompareBilinear(64, 32, true));
+}
+
+// Sevenths of the 224x224 view have no exact Q8 weight: each pass may be off
+// by 1/512 of the step between neighbours, plus half a deci Kelvin of rounding
+static void test_bilinear_close_to_float_at_224(void) {
+    const uint16_t span = 600;
+    RandomFrame(span);
+    double worst = CompareBilinear(224, 224, false);
+    char msg[64];
+    snprintf(msg, sizeof(msg), "worst %.3f dK from the float blend", worst);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE_MESSAGE(worst <= 0.5 + 2.0 * span / 512, msg);
+}
+
+// Catmull-Rom reproduces a linear gradient exactly away from the edges, and
+// stays within the Q8 weight error of the float kernel everywhere
+static void test_bicubic_against_reference(void) {
+    for (size_t n = 0; n < LAYOUT_COUNT; n++) {
+        const uint16_t width = layouts[n][0], height = layouts[n][1];
+        char msg[64];
+
+        for (int i = 0; i < HTPA_ROWS; i++) {
+            for (int j = 0; j < HTPA_COLS; j++) frame[i][j] = 2732 + 20 * i + 7 * j;
+        }
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, RENDER_ENGINE_BICUBIC, width, height, true));
+        Render_ScalerBegin(&scaler, &layout, frame);
+        for (uint16_t y = 0; y < height; y++) {
+            Render_ScalerRow(&scaler, y, 0, width, out);
+            double v = (double)y * HTPA_ROWS / height;
+            if (v < 1 || v >= HTPA_ROWS - 2) continue;
+            for (uint16_t x = 0; x < width; x++) {
+                double u = (double)x * HTPA_COLS / width;
+                if (u < 1 || u >= HTPA_COLS - 2) continue;
+                snprintf(msg, sizeof(msg), "%ux%u at %u, %u", width, height, x, y);
+                TEST_ASSERT_INT_WITHIN_MESSAGE(1, lround(2732 + 20 * v + 7 * (HTPA_COLS - 1 - u)), out[x], msg);
+            }
+        }
+        TEST_ASSERT_TRUE(CompareBicubic(width, height) <= 1.0);
+
+        const uint16_t span = 600;
+        RandomFrame(span);
+        double worst = CompareBicubic(width, height);
+        snprintf(msg, sizeof(msg), "%ux%u: worst %.3f dK from the float Catmull-Rom", width, height, worst);
+        TEST_MESSAGE(msg);
+        // up to 1/512 of the span per tap and pass, plus rounding
+        TEST_ASSERT_TRUE_MESSAGE(worst <= 0.5 + 2 * 4 * span / 512.0, msg);
+    }
+}
+
+static void test_nearest_replicates_cells(void) {
+    const uint16_t sizes[][2] = { { 224, 224 }, { 100, 70 }, { 320, 240 }, { 32, 32 } };
+
+    RandomFrame(600);
+    for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+        uint16_t width = sizes[n][0], height = sizes[n][1];
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, RENDER_ENGINE_NEAREST, width, height, true));
+        Render_ScalerBegin(&scaler, &layout, frame);
+        for (uint16_t y = 0; y < height; y++) {
+            Render_ScalerRow(&scaler, y, 0, width, out);
+            for (uint16_t x = 0; x < width; x++) {
+                int16_t expected = frame[y * HTPA_ROWS / height][HTPA_COLS - 1 - x * HTPA_COLS / width];
+                TEST_ASSERT_EQUAL_INT16(expected, out[x]);
+            }
+        }
+    }
+}
+
+static void test_flat_frame_stays_flat(void) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) frame[i][j] = 3011;
+    }
+    for (uint8_t engine = 0; engine < RENDER_ENGINE_COUNT; engine++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, engine, 224, 168, false));
+        Render_ScalerBegin(&scaler, &layout, frame);
+        for (uint16_t y = 0; y < 168; y++) {
+            Render_ScalerRow(&scaler, y, 0, 224, out);
+            for (uint16_t x = 0; x < 224; x++) TEST_ASSERT_EQUAL_INT16(3011, out[x]);
+        }
+    }
+}
+
+// Bands and tiles render parts of rows, in any order of rows
+static void test_partial_rows_match_full_rows(void) {
+    static int16_t full[RENDER_MAX_HEIGHT][RENDER_MAX_WIDTH];
+    const uint16_t width = 240, height = 180;
+
+    RandomFrame(600);
+    for (uint8_t engine = 0; engine < RENDER_ENGINE_COUNT; engine++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, engine, width, height, true));
+        Render_ScalerBegin(&scaler, &layout, frame);
+        for (uint16_t y = 0; y < height; y++) Render_ScalerRow(&scaler, y, 0, width, full[y]);
+
+        Render_ScalerBegin(&scaler, &layout, frame);
+        for (uint16_t n = 0; n < 400; n++) {
+            rng = rng * 1103515245 + 12345;
+            uint16_t y = (rng >> 8) % height, x = (rng >> 16) % width;
+            uint16_t count = 1 + (rng >> 4) % (width - x);
+            Render_ScalerRow(&scaler, y, x, count, out);
+            TEST_ASSERT_EQUAL_INT16_ARRAY(&full[y][x], out, count);
+        }
+    }
+}
+
+static double Elapsed(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+static double FrameTime(uint8_t engine, uint16_t width, uint16_t height, int frames) {
+    struct timespec start;
+    volatile int16_t sink = 0;
+
+    TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, engine, width, height, true));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames; n++) {
+        Render_ScalerBegin(&scaler, &layout, frame);
+        for (uint16_t y = 0; y < height; y++) {
+            Render_ScalerRow(&scaler, y, 0, width, out);
+            sink += out[y % width];
+        }
+    }
+    return Elapsed(&start) / frames;
+}
+
+// Host numbers per engine and layout, and the float blend of a 224x224 frame
+// as DrawHQImage did it
+static void test_scaler_throughput(void) {
+    static float image[224][224];
+    const int frames = 200;
+    struct timespec start;
+    volatile int16_t sink = 0;
+    char msg[96];
+
+    RandomFrame(600);
+    for (uint8_t engine = 0; engine < RENDER_ENGINE_COUNT; engine++) {
+        for (size_t n = 0; n < LAYOUT_COUNT; n++) {
+            const uint16_t width = layouts[n][0], height = layouts[n][1];
+            double us = FrameTime(engine, width, height, frames);
+            snprintf(msg, sizeof(msg), "%-8s %ux%u frame: %.1f us, %.2f ns per pixel",
+                     Render_Engines[engine].name, width, height, us, us * 1000 / (width * height));
+            TEST_MESSAGE(msg);
+            TEST_ASSERT_TRUE(us > 0);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames; n++) {
+        for (uint16_t y = 0; y < 224; y++) {
+            for (uint16_t x = 0; x < 224; x++) {
+                int baseRow = y / 7, nextRow = baseRow + 1 >= HTPA_ROWS ? baseRow : baseRow + 1;
+                int baseCol = x / 7, nextCol = baseCol + 1 >= HTPA_COLS ? baseCol : baseCol + 1;
+                float fx = (float)(x % 7) / 7, fy = (float)(y % 7) / 7;
+                image[y][x] = frame[baseRow][HTPA_COLS - baseCol - 1] * (1 - fx) * (1 - fy) +
+                              frame[baseRow][HTPA_COLS - nextCol - 1] * fx * (1 - fy) +
+                              frame[nextRow][HTPA_COLS - baseCol - 1] * (1 - fx) * fy +
+                              frame[nextRow][HTPA_COLS - nextCol - 1] * fx * fy;
+            }
+        }
+        sink += (int16_t)image[n % 224][n % 224];
+    }
+    double float_us = Elapsed(&start) / frames;
+
+    snprintf(msg, sizeof(msg), "float    224x224 frame: %.1f us", float_us);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(float_us > 0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bilinear_bit_exact_for_dyadic_phases);
+    RUN_TEST(test_bilinear_close_to_float_at_224);
+    RUN_TEST(test_bicubic_against_reference);
+    RUN_TEST(test_nearest_replicates_cells);
+    RUN_TEST(test_flat_frame_stays_flat);
+    RUN_TEST(test_partial_rows_match_full_rows);
+    RUN_TEST(test_scaler_throughput);
+    return UNITY_END();
+}
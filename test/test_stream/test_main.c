@@ -0,0 +1,178 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "render.h"
+#include "palette.h"
+
+// Band streaming through the ping-pong buffers against a mock DMA engine. A
+// transfer started by the flush callback reads its band when it completes,
+// which is when the next transfer starts or the caller waits for the bus,
+// like TFT_eSPI pushImageDMA and dmaWait. A band written while in flight
+// arrives on the mock screen different from what was flushed.
+
+#define WIDTH           224
+#define HEIGHT          224
+#define BAND_HEIGHT     8
+
+typedef struct {
+    const uint16_t *buf;            // band in flight, NULL when idle
+    uint32_t sum;                   // its contents when flushed
+    uint16_t x, y, w, rows;
+    uint32_t transfers;
+    uint32_t touched;               // bands changed while in flight
+    uint16_t screen[HEIGHT][WIDTH];
+} Dma_t;
+
+static Dma_t dma;
+static uint16_t buf0[RENDER_MAX_WIDTH * BAND_HEIGHT], buf1[RENDER_MAX_WIDTH * BAND_HEIGHT];
+static Render_Stream_t stream;
+static Render_Layout_t layout;
+static Render_Scaler_t scaler;
+static Render_Delta_t delta;
+static Render_Map_t map;
+static int16_t frame[HTPA_ROWS][HTPA_COLS];
+static int16_t line[RENDER_MAX_WIDTH];
+static uint16_t reference[HEIGHT][WIDTH];
+
+static uint32_t Checksum(const uint16_t *buf, uint32_t count) {
+    uint32_t sum = 0;
+    for (uint32_t n = 0; n < count; n++) sum = sum * 31 + buf[n];
+    return sum;
+}
+
+static void DmaWait(void) {
+    if (!dma.buf) return;
+    if (Checksum(dma.buf, (uint32_t)dma.w * dma.rows) != dma.sum) dma.touched++;
+    for (uint16_t row = 0; row < dma.rows; row++) {
+        memcpy(&dma.screen[dma.y + row][dma.x], dma.buf + (uint32_t)row * dma.w, dma.w * sizeof(uint16_t));
+    }
+    dma.buf = NULL;
+}
+
+static void PushBand(Render_Target_t *band, uint16_t x, uint16_t y, uint16_t rows, void *arg) {
+    TEST_ASSERT_EQUAL_PTR(&dma, arg);
+    TEST_ASSERT_TRUE(rows <= band->height && band->width == band->stride);
+    // two flushes in a row never hand over the same buffer
+    TEST_ASSERT_TRUE(band->buf != dma.buf);
+    DmaWait();
+    dma.buf = band->buf;
+    dma.sum = Checksum(band->buf, (uint32_t)band->width * rows);
+    dma.x = x;
+    dma.y = y;
+    dma.w = band->width;
+    dma.rows = rows;
+    dma.transfers++;
+}
+
+void setUp(void) {
+    memset(&dma, 0, sizeof(dma));
+    TEST_ASSERT_EQUAL(HTPA_OK, Render_StreamInit(&stream, buf0, buf1, RENDER_MAX_WIDTH, BAND_HEIGHT, PushBand, &dma));
+    TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, RENDER_ENGINE_BILINEAR, WIDTH, HEIGHT, true));
+    Render_DeltaInit(&delta, layout.engine->before, layout.engine->after);
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 2932, 3332);
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) frame[i][j] = 2932 + (i * 37 + j * 11) % 400;
+    }
+}
+
+void tearDown(void) {}
+
+// The band loop of DrawImage, one band per row of tiles cut to its dirty span
+static uint32_t DrawImage(bool full) {
+    uint32_t bands = 0;
+
+    Render_DeltaUpdate(&delta, frame, true, &map, full);
+    Render_ScalerBegin(&scaler, &layout, frame);
+    for (int tileRow = 0; tileRow < HTPA_ROWS; tileRow++) {
+        uint32_t dirty = delta.dirty[tileRow];
+        if (!dirty) continue;
+        uint16_t x = layout.colStart[__builtin_ctz(dirty)];
+        uint16_t width = layout.colStart[32 - __builtin_clz(dirty)] - x;
+        uint16_t top = layout.rowStart[tileRow];
+        uint16_t rows = layout.rowStart[tileRow + 1] - top;
+
+        Render_Target_t *band = Render_StreamBand(&stream, width);
+        // the band handed out is never the one in flight
+        TEST_ASSERT_TRUE(band->buf != dma.buf);
+        TEST_ASSERT_TRUE(rows <= band->height);
+        for (uint16_t y = 0; y < rows; y++) {
+            Render_ScalerRow(&scaler, top + y, x, width, line);
+            Render_Colorize(line, Render_TargetRow(band, y), width, &map);
+        }
+        Render_StreamFlush(&stream, x, top, rows);
+        bands++;
+    }
+    DmaWait();
+    return bands;
+}
+
+static void RenderReference(void) {
+    Render_ScalerBegin(&scaler, &layout, frame);
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        Render_ScalerRow(&scaler, y, 0, WIDTH, line);
+        Render_Colorize(line, reference[y], WIDTH, &map);
+    }
+}
+
+static void test_init_needs_both_buffers_and_a_flush(void) {
+    TEST_ASSERT_EQUAL(HTPA_ERR, Render_StreamInit(&stream, NULL, buf1, RENDER_MAX_WIDTH, BAND_HEIGHT, PushBand, NULL));
+    TEST_ASSERT_EQUAL(HTPA_ERR, Render_StreamInit(&stream, buf0, NULL, RENDER_MAX_WIDTH, BAND_HEIGHT, PushBand, NULL));
+    TEST_ASSERT_EQUAL(HTPA_ERR, Render_StreamInit(&stream, buf0, buf1, RENDER_MAX_WIDTH, BAND_HEIGHT, NULL, NULL));
+}
+
+static void test_bands_alternate_buffers(void) {
+    const uint16_t *last = NULL;
+
+    for (int n = 0; n < 6; n++) {
+        Render_Target_t *band = Render_StreamBand(&stream, 10 + n);
+        TEST_ASSERT_TRUE(band->buf == buf0 || band->buf == buf1);
+        TEST_ASSERT_TRUE(band->buf != last);
+        TEST_ASSERT_EQUAL_UINT16(10 + n, band->width);
+        TEST_ASSERT_EQUAL_UINT16(10 + n, band->stride);
+        Render_Fill(band, n);
+        last = band->buf;
+        Render_StreamFlush(&stream, 0, n, 1);
+    }
+    DmaWait();
+    TEST_ASSERT_EQUAL_UINT32(6, dma.transfers);
+    TEST_ASSERT_EQUAL_UINT32(0, dma.touched);
+}
+
+static void test_full_frame_arrives_intact(void) {
+    TEST_ASSERT_EQUAL_UINT32(HTPA_ROWS, DrawImage(true));
+    RenderReference();
+    TEST_ASSERT_EQUAL_UINT32(0, dma.touched);
+    TEST_ASSERT_EQUAL_UINT32(HTPA_ROWS, dma.transfers);
+    TEST_ASSERT_EQUAL_MEMORY(reference, dma.screen, sizeof(reference));
+}
+
+// Only the tiles around changed cells are sent, and the screen ends up as
+// a full redraw of the new frame
+static void test_dirty_bands_update_the_screen(void) {
+    DrawImage(true);
+    uint32_t transfers = dma.transfers;
+
+    frame[3][5] += 200;
+    frame[20][30] -= 150;
+    frame[21][0] += 300;
+    uint32_t bands = DrawImage(false);
+    TEST_ASSERT_GREATER_THAN(0, bands);
+    TEST_ASSERT_LESS_THAN(HTPA_ROWS, bands);
+    TEST_ASSERT_EQUAL_UINT32(transfers + bands, dma.transfers);
+
+    RenderReference();
+    TEST_ASSERT_EQUAL_UINT32(0, dma.touched);
+    TEST_ASSERT_EQUAL_MEMORY(reference, dma.screen, sizeof(reference));
+
+    // nothing changed, nothing sent
+    TEST_ASSERT_EQUAL_UINT32(0, DrawImage(false));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_needs_both_buffers_and_a_flush);
+    RUN_TEST(test_bands_alternate_buffers);
+    RUN_TEST(test_full_frame_arrives_intact);
+    RUN_TEST(test_dirty_bands_update_the_screen);
+    return UNITY_END();
+}
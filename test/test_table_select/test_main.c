@@ -0,0 +1,107 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+#include "lookuptable.h"
+
+// Lookup table selection by the table number in the EEPROM. The test has its
+// own copy of the table list, so entries are compared by name.
+
+#define TABLE_COUNT     (sizeof(HTPA_Tables) / sizeof(HTPA_Tables[0]))
+
+static HTPA_Data_t data;
+static HTPA_EEPROM_Data_t eeprom;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const HTPA_Table_t *Listed(uint16_t TN, uint8_t variant) {
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        if (HTPA_Tables[i].TN == TN && HTPA_Tables[i].variant == variant) return &HTPA_Tables[i];
+    }
+    return NULL;
+}
+
+static void test_every_entry_is_found(void) {
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        const HTPA_Table_t *table = HTPA_FindTable(HTPA_Tables[i].TN, HTPA_Tables[i].variant);
+        TEST_ASSERT_NOT_NULL_MESSAGE(table, HTPA_Tables[i].name);
+        TEST_ASSERT_EQUAL_STRING(HTPA_Tables[i].name, table->name);
+        TEST_ASSERT_EQUAL_UINT16(HTPA_Tables[i].TN, table->TN);
+        TEST_ASSERT_EQUAL_UINT8(HTPA_Tables[i].variant, table->variant);
+    }
+}
+
+// A variant the sensor has no table for falls back to its standard table
+static void test_missing_variant_falls_back_to_standard(void) {
+    int fallbacks = 0;
+
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        const uint16_t TN = HTPA_Tables[i].TN;
+        for (uint8_t variant = HTPA_TABLE_STANDARD; variant <= HTPA_TABLE_FEVER; variant++) {
+            if (Listed(TN, variant)) continue;
+            const HTPA_Table_t *standard = Listed(TN, HTPA_TABLE_STANDARD);
+            const HTPA_Table_t *table = HTPA_FindTable(TN, variant);
+            if (!standard) {
+                TEST_ASSERT_NULL(table);
+                continue;
+            }
+            TEST_ASSERT_NOT_NULL(table);
+            TEST_ASSERT_EQUAL_STRING(standard->name, table->name);
+            fallbacks++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(0, fallbacks);
+}
+
+static void test_unknown_table_number_has_no_table(void) {
+    for (uint32_t TN = 0; TN <= 0xFFFF; TN++) {
+        bool listed = false;
+        for (size_t i = 0; i < TABLE_COUNT; i++) listed |= HTPA_Tables[i].TN == TN;
+        if (listed) continue;
+        for (uint8_t variant = HTPA_TABLE_STANDARD; variant <= HTPA_TABLE_FEVER; variant++) {
+            TEST_ASSERT_NULL(HTPA_FindTable(TN, variant));
+        }
+    }
+}
+
+// The fixed point engine sizes its plan by HTPA_MAX_AD_ELEMENTS and steps
+// through the ambient columns by TaEquidistance
+static void test_tables_fit_the_engine(void) {
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        const HTPA_Table_t *table = &HTPA_Tables[i];
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(HTPA_MAX_AD_ELEMENTS, table->NrOfAdElements, table->name);
+        TEST_ASSERT_GREATER_THAN_MESSAGE(1, table->NrOfTaElements, table->name);
+        for (int n = 1; n < table->NrOfTaElements; n++) {
+            TEST_ASSERT_EQUAL_MESSAGE(table->TaEquidistance, table->XTATemps[n] - table->XTATemps[n - 1], table->name);
+        }
+    }
+}
+
+static void test_init_selects_the_sensor_table(void) {
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        if (HTPA_Tables[i].variant != HTPA_TABLE_VARIANT) continue;
+        HTPA_SimReset(HTPA_Tables[i].TN);
+        TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+        TEST_ASSERT_NOT_NULL(HTPA_GetTable());
+        TEST_ASSERT_EQUAL_STRING(HTPA_Tables[i].name, HTPA_GetTable()->name);
+    }
+}
+
+static void test_init_fails_for_unknown_sensor(void) {
+    HTPA_SimReset(999);
+    TEST_ASSERT_NULL(HTPA_FindTable(999, HTPA_TABLE_VARIANT));
+    TEST_ASSERT_EQUAL(HTPA_ERR, HTPA_Init(&data, &eeprom, 0, 0, 0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_entry_is_found);
+    RUN_TEST(test_missing_variant_falls_back_to_standard);
+    RUN_TEST(test_unknown_table_number_has_no_table);
+    RUN_TEST(test_tables_fit_the_engine);
+    RUN_TEST(test_init_selects_the_sensor_table);
+    RUN_TEST(test_init_fails_for_unknown_sensor);
+    return UNITY_END();
+}
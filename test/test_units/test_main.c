@@ -0,0 +1,46 @@
+#include <unity.h>
+#include <stdio.h>
+#include "htpa.h"
+
+// Conversions between deci Kelvin and degrees Celsius
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void test_known_temperatures(void) {
+    TEST_ASSERT_EQUAL_INT16(2732, HTPA_C_TO_DK(0.0f));      // 273.15 K rounds up
+    TEST_ASSERT_EQUAL_INT16(2982, HTPA_C_TO_DK(25.0f));
+    TEST_ASSERT_EQUAL_INT16(HTPA_HIST_BASE, HTPA_C_TO_DK(-40.0f));
+    TEST_ASSERT_EQUAL_INT16(3098, HTPA_C_TO_DK(36.6f));
+    TEST_ASSERT_EQUAL_INT16(3731, HTPA_C_TO_DK(99.97f));
+    TEST_ASSERT_EQUAL_INT16(2731, HTPA_C_TO_DK(-0.06f));
+    TEST_ASSERT_EQUAL_INT16(0, HTPA_C_TO_DK(-273.15f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 26.85f, HTPA_DK_TO_C(3000));
+}
+
+// Every deci Kelvin survives the way through Celsius
+static void test_deci_kelvin_round_trip(void) {
+    for (int dk = 0; dk <= INT16_MAX; dk++) {
+        TEST_ASSERT_EQUAL_INT16(dk, HTPA_C_TO_DK(HTPA_DK_TO_C(dk)));
+    }
+}
+
+// Celsius comes back within half a deci Kelvin, below and above zero
+static void test_celsius_round_trip(void) {
+    for (int n = -4000; n <= 30000; n++) {
+        float c = n * 0.01f;
+        float back = HTPA_DK_TO_C(HTPA_C_TO_DK(c));
+        char msg[48];
+        snprintf(msg, sizeof(msg), "%.2f *C came back as %.3f *C", c, back);
+        TEST_ASSERT_TRUE_MESSAGE(fabsf(back - c) <= 0.05f + 1e-4f, msg);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_known_temperatures);
+    RUN_TEST(test_deci_kelvin_round_trip);
+    RUN_TEST(test_celsius_round_trip);
+    return UNITY_END();
+}
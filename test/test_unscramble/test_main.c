@@ -0,0 +1,189 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "htpa.h"
+#include "htpa_sim.h"
+#include "unscramble_golden.h"
+
+// Table driven unscramble against the nested loops it replaced, and a golden
+// frame from raw block readouts to deci Kelvin through the fixed point engine.
+// Build with -DUNSCRAMBLE_PRINT_GOLDEN to capture a new frame from the
+// simulator and print unscramble_golden.h after an intended change.
+
+// Raw readouts of htpa.c: PTAT or VDD word, then 128 big endian pixels
+extern uint8_t data_top[4][258];
+extern uint8_t data_bottom[4][258];
+extern uint8_t electrical_offset_top[258];
+extern uint8_t electrical_offset_bottom[258];
+
+static HTPA_Data_t data, ref;
+static HTPA_EEPROM_Data_t eeprom;
+static uint32_t rng;
+
+void setUp(void) {
+    rng = 7;
+    HTPA_SimReset(114);
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_Init(&data, &eeprom, 0, 0, 0));
+}
+
+void tearDown(void) {}
+
+static void RandomBytes(uint8_t *buf, size_t len) {
+    for (size_t n = 0; n < len; n++) {
+        rng = rng * 1103515245 + 12345;
+        buf[n] = rng >> 16;
+    }
+}
+
+// HTPA_SortData before the sort tables
+static void NestedLoopSort(HTPA_Data_t *data) {
+    for (int block = 0; block < 4; block++) {
+        for (int j = 0; j < 32; j++) {
+            for (int i = 0; i < 4; i++) {
+                data->pixelData[block * 4 + i][j] = (data_top[block][2 * (j + i * 32) + 2] << 8) | data_top[block][2 * (j + i * 32) + 3];
+                data->pixelData[16 + block * 4 + i][j] = (data_bottom[3 - block][2 * j + (3 - i) * 64 + 2] << 8) | data_bottom[3 - block][2 * j + (3 - i) * 64 + 3];
+            }
+        }
+    }
+
+    for (int j = 0; j < 32; j++) {
+        for (int i = 0; i < 4; i++) {
+            data->electricalOffsets[i][j] = (electrical_offset_top[2 * (j + i * 32) + 2] << 8) | electrical_offset_top[2 * (j + i * 32) + 3];
+            data->electricalOffsets[4 + i][j] = (electrical_offset_bottom[2 * (j + (3 - i) * 32) + 2] << 8) | electrical_offset_bottom[2 * (j + (3 - i) * 32) + 3];
+        }
+    }
+
+    uint32_t ptat_sum = 0;
+    uint32_t vdd_sum = 0;
+    for (int i = 0; i < 8; i++) {
+        vdd_sum += data->VDD[i];
+        ptat_sum += data->PTAT[i];
+    }
+    data->VDDav = (uint16_t)(vdd_sum / 8);
+    data->PTATav = (uint16_t)(ptat_sum / 8);
+}
+
+static void RandomReadouts(void) {
+    RandomBytes(&data_top[0][0], sizeof(data_top));
+    RandomBytes(&data_bottom[0][0], sizeof(data_bottom));
+    RandomBytes(electrical_offset_top, sizeof(electrical_offset_top));
+    RandomBytes(electrical_offset_bottom, sizeof(electrical_offset_bottom));
+    for (int i = 0; i < 8; i++) {
+        data.PTAT[i] = ref.PTAT[i] = 30000 + i * 11;
+        data.VDD[i] = ref.VDD[i] = 31000 + i * 13;
+    }
+}
+
+static void test_unscramble_matches_nested_loops(void) {
+    for (int n = 0; n < 20; n++) {
+        RandomReadouts();
+        NestedLoopSort(&ref);
+        HTPA_SortData(&data);
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(&ref.pixelData[0][0], &data.pixelData[0][0], HTPA_PIXELS);
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(&ref.electricalOffsets[0][0], &data.electricalOffsets[0][0], HTPA_BLOCKS * 2 * HTPA_COLS);
+        TEST_ASSERT_EQUAL_UINT16(ref.PTATav, data.PTATav);
+        TEST_ASSERT_EQUAL_UINT16(ref.VDDav, data.VDDav);
+    }
+}
+
+static double Elapsed(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+// Host numbers of a whole frame and blind frame, as HTPA_SortData sorts them
+static void test_unscramble_throughput(void) {
+    const int frames = 5000;
+    struct timespec start;
+
+    RandomReadouts();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames; n++) {
+        NestedLoopSort(&ref);
+        __asm__ volatile("" : : "r"(&ref) : "memory");
+    }
+    double loops_us = Elapsed(&start) / frames;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < frames; n++) {
+        HTPA_SortData(&data);
+        __asm__ volatile("" : : "r"(&data) : "memory");
+    }
+    double table_us = Elapsed(&start) / frames;
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "per frame: nested loops %.2f us, sort table %.2f us", loops_us, table_us);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(loops_us > 0 && table_us > 0);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(&ref.pixelData[0][0], &data.pixelData[0][0], HTPA_PIXELS);
+}
+
+#ifdef UNSCRAMBLE_PRINT_GOLDEN
+static void PrintBytes(const char *name, const uint8_t *buf, size_t len) {
+    printf("static const uint8_t %s[%u] = {", name, (unsigned)len);
+    for (size_t n = 0; n < len; n++) printf("%s0x%02X,", n % 16 ? " " : "\n    ", buf[n]);
+    printf("\n};\n\n");
+}
+
+static void PrintWords(const char *type, const char *name, const void *buf, size_t len, bool sign) {
+    printf("static const %s %s[%u] = {", type, name, (unsigned)len);
+    for (size_t n = 0; n < len; n++) {
+        int v = sign ? ((const int16_t *)buf)[n] : ((const uint16_t *)buf)[n];
+        printf("%s%5d,", n % 16 ? " " : "\n    ", v);
+    }
+    printf("\n};\n\n");
+}
+#endif
+
+// Sorting and the fixed point engine from the raw readouts of a simulated
+// frame of table 114 must give exactly the golden temperatures
+static void test_golden_frame(void) {
+#ifdef UNSCRAMBLE_PRINT_GOLDEN
+    sim_signal = 2000;
+    sim_noise = 3000;
+    HTPA_SetFilter(false);
+    HTPA_SetOversampling(1);
+    for (int n = 0; n < 4; n++) TEST_ASSERT_EQUAL(HTPA_OK, HTPA_CaptureData(&data, &eeprom));
+    TEST_ASSERT_EQUAL(HTPA_OK, HTPA_GetElOffsets());
+    const uint16_t *ptat = data.PTAT, *vdd = data.VDD;
+#else
+    memcpy(data_top, GoldenTop, sizeof(data_top));
+    memcpy(data_bottom, GoldenBottom, sizeof(data_bottom));
+    memcpy(electrical_offset_top, GoldenElOffsetTop, sizeof(electrical_offset_top));
+    memcpy(electrical_offset_bottom, GoldenElOffsetBottom, sizeof(electrical_offset_bottom));
+    const uint16_t *ptat = GoldenPTAT, *vdd = GoldenVDD;
+#endif
+    for (int i = 0; i < 8; i++) {
+        ref.PTAT[i] = ptat[i];
+        ref.VDD[i] = vdd[i];
+    }
+    HTPA_SortData(&ref);
+    HTPA_CalculateTemperatures(&ref, &eeprom);
+
+#ifdef UNSCRAMBLE_PRINT_GOLDEN
+    printf("#ifndef _UNSCRAMBLE_GOLDEN_H_\n#define _UNSCRAMBLE_GOLDEN_H_\n\n");
+    printf("#include <stdint.h>\n\n");
+    printf("// Raw readouts of a simulated frame of table 114 and its temperatures in\n");
+    printf("// deci Kelvin, printed by test_unscramble with -DUNSCRAMBLE_PRINT_GOLDEN\n\n");
+    PrintBytes("GoldenTop", &data_top[0][0], sizeof(data_top));
+    PrintBytes("GoldenBottom", &data_bottom[0][0], sizeof(data_bottom));
+    PrintBytes("GoldenElOffsetTop", electrical_offset_top, sizeof(electrical_offset_top));
+    PrintBytes("GoldenElOffsetBottom", electrical_offset_bottom, sizeof(electrical_offset_bottom));
+    PrintWords("uint16_t", "GoldenPTAT", ptat, 8, false);
+    PrintWords("uint16_t", "GoldenVDD", vdd, 8, false);
+    PrintWords("int16_t", "GoldenTemps", &ref.pixelTemps[0][0], HTPA_PIXELS, true);
+    printf("#endif\n");
+#else
+    TEST_ASSERT_EQUAL_INT16_ARRAY(GoldenTemps, &ref.pixelTemps[0][0], HTPA_PIXELS);
+#endif
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_unscramble_matches_nested_loops);
+    RUN_TEST(test_unscramble_throughput);
+    RUN_TEST(test_golden_frame);
+    return UNITY_END();
+}
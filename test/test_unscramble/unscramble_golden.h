@@ -0,0 +1,260 @@
+#ifndef _UNSCRAMBLE_GOLDEN_H_
+#define _UNSCRAMBLE_GOLDEN_H_
+
+#include <stdint.h>
+
+// Raw readouts of a simulated frame of table 114 and its temperatures in
+// deci Kelvin, printed by test_unscramble with -DUNSCRAMBLE_PRINT_GOLDEN
+
+static const uint8_t GoldenTop[1032] = {
+    0x94, 0x70, 0x97, 0x5D, 0x9A, 0xF0, 0x92, 0x9E, 0x96, 0xA6, 0x97, 0x1E, 0x96, 0x62, 0x94, 0xB9,
+    0x9C, 0x63, 0x9C, 0xDE, 0x94, 0x54, 0x9A, 0x85, 0x9D, 0x80, 0x9C, 0x6D, 0x95, 0x09, 0x9C, 0xFC,
+    0x94, 0x83, 0x97, 0x6B, 0x94, 0x6B, 0x94, 0x17, 0x99, 0xF6, 0x9D, 0xA8, 0x9B, 0x54, 0x94, 0xA6,
+    0x98, 0x79, 0x96, 0xE0, 0x9A, 0xBF, 0x9A, 0x8D, 0x9E, 0xAD, 0x95, 0x9F, 0x96, 0xBD, 0x9D, 0x1B,
+    0x9D, 0x80, 0x9A, 0x21, 0x97, 0xBA, 0x99, 0xC3, 0x95, 0xB5, 0x9E, 0x7F, 0x96, 0xCF, 0x96, 0xE5,
+    0x96, 0xA3, 0x9B, 0xE0, 0x99, 0xE0, 0x9B, 0xFC, 0x95, 0x8C, 0x97, 0xE3, 0x99, 0x1E, 0x9C, 0x8F,
+    0x98, 0x2E, 0x9D, 0xB7, 0x95, 0x4D, 0x9F, 0xB2, 0x9E, 0x8B, 0x96, 0xCD, 0x9C, 0x65, 0x95, 0xC5,
+    0x98, 0xC3, 0x9C, 0xAB, 0x98, 0x2A, 0x9F, 0x12, 0x99, 0x66, 0x9C, 0xE9, 0x9B, 0x5D, 0xA0, 0x29,
+    0x9B, 0x15, 0x99, 0x75, 0x9E, 0xC3, 0x9D, 0xB5, 0x9A, 0xF8, 0x9F, 0x09, 0x95, 0xFC, 0x9B, 0x36,
+    0x9F, 0xAF, 0xA0, 0x02, 0x98, 0x43, 0x97, 0xB7, 0x9F, 0x13, 0x98, 0x59, 0x97, 0xFA, 0x99, 0x2F,
+    0x96, 0xBC, 0xA0, 0xDC, 0xA0, 0x9D, 0x98, 0x83, 0x97, 0x2B, 0x9E, 0x64, 0x9D, 0x1C, 0x9E, 0x78,
+    0x9C, 0xB7, 0x99, 0xFE, 0x9E, 0x7C, 0x9E, 0x2B, 0x9C, 0x23, 0x9E, 0x9C, 0x97, 0xBD, 0x9C, 0x5B,
+    0x9E, 0xA4, 0xA0, 0xF3, 0x93, 0x99, 0x95, 0xDA, 0x94, 0x2B, 0x95, 0x62, 0x95, 0xC5, 0x9C, 0x5A,
+    0x93, 0xCB, 0x9A, 0xC4, 0x98, 0x3B, 0x95, 0x95, 0x9E, 0x23, 0x93, 0x7E, 0x95, 0x83, 0x9E, 0x02,
+    0x95, 0x43, 0x95, 0x48, 0x98, 0x8B, 0x95, 0x0E, 0x96, 0xFC, 0x9D, 0xB1, 0x99, 0x81, 0x94, 0x3E,
+    0x9D, 0xED, 0x93, 0xC0, 0x97, 0x5B, 0x94, 0x70, 0x95, 0x48, 0x9C, 0x8D, 0x9D, 0xB9, 0x99, 0xA9,
+    0x9E, 0x5C, 0x94, 0x70, 0x9D, 0x5F, 0x9A, 0x58, 0x9A, 0x9D, 0x99, 0xFB, 0x99, 0xC6, 0x9C, 0x2F,
+    0x99, 0x24, 0x9F, 0x23, 0x9C, 0xD8, 0x9A, 0xF3, 0x97, 0xB1, 0x96, 0x00, 0x95, 0x26, 0x99, 0xC5,
+    0x9D, 0x74, 0x99, 0x5E, 0x94, 0xE6, 0x9B, 0x59, 0x96, 0xC0, 0x9F, 0xA9, 0x9B, 0x61, 0x98, 0x06,
+    0x9D, 0x23, 0x98, 0x4F, 0x99, 0x44, 0x9B, 0xD3, 0x9D, 0xAA, 0x97, 0xE2, 0x9E, 0x89, 0xA0, 0x2E,
+    0x9D, 0xE5, 0x9B, 0xD1, 0x95, 0x46, 0x9D, 0xBD, 0x9A, 0x65, 0x99, 0x3E, 0x9E, 0x0A, 0xA0, 0x48,
+    0x9A, 0xB3, 0x9D, 0x17, 0x98, 0xA5, 0x9A, 0xBA, 0x95, 0xAB, 0x98, 0xAF, 0x9F, 0x9F, 0x9A, 0x35,
+    0x97, 0xDB, 0x9B, 0x84, 0x9E, 0xF5, 0x97, 0xD5, 0x98, 0x26, 0x9A, 0x01, 0x9F, 0x5A, 0x9B, 0xE3,
+    0x9F, 0x8D, 0x9D, 0xCC, 0x9F, 0x32, 0x96, 0x71, 0x96, 0x02, 0x96, 0xDF, 0x97, 0xF6, 0x98, 0xA2,
+    0x9E, 0x1E, 0x9D, 0x70, 0xA1, 0x95, 0x9B, 0xB1, 0x95, 0xA0, 0x94, 0x71, 0x98, 0x85, 0x99, 0xFD,
+    0x95, 0x65, 0x97, 0xEB, 0x9C, 0x81, 0x9B, 0xCE, 0x92, 0xDF, 0x9D, 0x2F, 0x92, 0xEE, 0x94, 0x6B,
+    0x96, 0x84, 0x98, 0xAB, 0x99, 0x7B, 0x9E, 0x2F, 0x93, 0xD7, 0x94, 0xAA, 0x9B, 0xE9, 0x98, 0xFB,
+    0x9C, 0x01, 0x95, 0xF1, 0x98, 0x66, 0x93, 0xFD, 0x96, 0xE5, 0x97, 0x34, 0x93, 0xB2, 0x9E, 0x5B,
+    0x9B, 0xF9, 0x96, 0xB9, 0x9D, 0x0B, 0x95, 0x7A, 0x9A, 0xCA, 0x9D, 0xF1, 0x94, 0xDB, 0x96, 0x8B,
+    0x99, 0x2E, 0x9A, 0x6C, 0x99, 0x8F, 0x97, 0x3B, 0x95, 0x02, 0x94, 0xBC, 0x9B, 0x60, 0x95, 0xD8,
+    0x96, 0xB4, 0x9F, 0x77, 0x96, 0x44, 0x9F, 0x91, 0x9A, 0x8F, 0x98, 0x87, 0x9B, 0x53, 0x9E, 0xCD,
+    0x94, 0x84, 0x99, 0x84, 0x97, 0xCC, 0x95, 0x30, 0x9E, 0x5E, 0x96, 0x46, 0x9B, 0x50, 0x9F, 0xB4,
+    0x98, 0xCB, 0x96, 0xBE, 0x94, 0x70, 0x95, 0x6C, 0x97, 0xC4, 0x9F, 0x80, 0x9E, 0x14, 0x9F, 0xEA,
+    0x9F, 0xF0, 0x9B, 0x54, 0xA0, 0x70, 0x9F, 0x0E, 0x9A, 0x3E, 0xA0, 0x59, 0x96, 0xC4, 0x99, 0xE3,
+    0x9B, 0x2D, 0x98, 0xB8, 0x9E, 0x6D, 0x9B, 0xC5, 0x9D, 0xBA, 0x98, 0x74, 0x9B, 0xE8, 0x98, 0xE6,
+    0x9E, 0x85, 0x96, 0x3C, 0x9E, 0x81, 0x9C, 0xE4, 0x9F, 0xA3, 0x9B, 0x84, 0x9B, 0xC3, 0xA1, 0x57,
+    0x9B, 0x9C, 0x97, 0x23, 0xA1, 0x3E, 0x9D, 0x56, 0x9E, 0x74, 0x9F, 0xDB, 0x9A, 0xF0, 0x94, 0x17,
+    0x9C, 0x12, 0x97, 0x6C, 0x94, 0xAD, 0x97, 0x4C, 0x98, 0xDE, 0x95, 0x14, 0x95, 0xC4, 0x9A, 0xAC,
+    0x99, 0xDF, 0x9C, 0xE8, 0x9B, 0x8D, 0x93, 0x9D, 0x98, 0xA0, 0x97, 0x6C, 0x93, 0x51, 0x9C, 0x88,
+    0x9D, 0x2A, 0x9D, 0x2F, 0x99, 0xF7, 0x9A, 0x82, 0x98, 0x73, 0x95, 0xBD, 0x9A, 0x99, 0x9A, 0xFD,
+    0x97, 0x51, 0x99, 0x94, 0x95, 0xDE, 0x9E, 0xD7, 0x9E, 0x39, 0x9E, 0x19, 0x94, 0xD8, 0x96, 0x3F,
+    0x9D, 0x94, 0x97, 0x1B, 0x94, 0xDE, 0x98, 0x5D, 0x9B, 0x77, 0x97, 0x8D, 0x9E, 0x01, 0x96, 0xA9,
+    0x9C, 0xB1, 0x94, 0xC6, 0x9F, 0x29, 0x9A, 0x70, 0x9C, 0x76, 0x97, 0xFA, 0x98, 0xC7, 0x99, 0xFD,
+    0x98, 0x30, 0x95, 0xB8, 0x98, 0x11, 0x96, 0xFB, 0x9D, 0x33, 0x9E, 0x04, 0x95, 0x94, 0x99, 0x0E,
+    0x9E, 0x06, 0x9F, 0x9D, 0x98, 0x74, 0x99, 0x4A, 0x9B, 0x9F, 0x9C, 0xFE, 0x9E, 0x83, 0x99, 0x20,
+    0x9A, 0x9E, 0x96, 0xDF, 0x96, 0x8A, 0x97, 0x5E, 0xA0, 0xDE, 0x9A, 0x03, 0x95, 0x59, 0x95, 0x86,
+    0x98, 0x32, 0x97, 0x31, 0x9D, 0x2F, 0xA1, 0x0C, 0x9C, 0x94, 0x97, 0x65, 0x9C, 0x47, 0x98, 0x42,
+    0x9D, 0x9D, 0x9F, 0xEF, 0x9C, 0x4F, 0x9F, 0x4D, 0x9F, 0xA2, 0x9B, 0x50, 0x97, 0xF9, 0xA0, 0xFF,
+    0x9C, 0xA3, 0xA1, 0x02, 0x97, 0x14, 0x94, 0x70, 0x97, 0x2E, 0xA1, 0xDC, 0x9F, 0xB0, 0x9A, 0x29,
+    0x9D, 0xE0, 0x9B, 0x5C, 0x97, 0xB5, 0x95, 0x87, 0x96, 0x06, 0x93, 0x2B, 0x9B, 0x4B, 0x95, 0x0A,
+    0x9D, 0x29, 0x94, 0xC7, 0x96, 0xEF, 0x97, 0x1F, 0x96, 0x76, 0x9A, 0xB6, 0x99, 0x43, 0x99, 0x90,
+    0x94, 0x76, 0x96, 0x86, 0x93, 0xCF, 0x9A, 0xDD, 0x96, 0x16, 0x99, 0x9D, 0x9C, 0x3F, 0x9D, 0xBF,
+    0x9E, 0x18, 0x93, 0xE4, 0x9E, 0x82, 0x9D, 0x94, 0x97, 0x51, 0x97, 0x35, 0x9A, 0xDC, 0x97, 0xC8,
+    0x97, 0xCA, 0x9E, 0x9A, 0x9C, 0xF3, 0x9D, 0x88, 0x9D, 0xD1, 0x9D, 0x00, 0x96, 0x4B, 0x97, 0x4F,
+    0x9E, 0x60, 0x95, 0x16, 0x9D, 0xE3, 0x97, 0x13, 0x9C, 0xBB, 0x94, 0xA8, 0x97, 0xC8, 0x94, 0xFE,
+    0x97, 0xF5, 0x9D, 0x38, 0x98, 0x47, 0x95, 0xF8, 0x94, 0x99, 0x94, 0xE2, 0x9D, 0xF5, 0x95, 0xDA,
+    0xA0, 0x43, 0x9E, 0x4D, 0x9A, 0x59, 0x98, 0xCA, 0x9A, 0xD6, 0x9B, 0x3F, 0x9D, 0xEF, 0x97, 0xB3,
+    0xA0, 0x5D, 0x9F, 0xE8, 0x9E, 0x95, 0x9F, 0x94, 0x9D, 0x8D, 0x9A, 0x04, 0x9A, 0x17, 0xA0, 0xAF,
+    0x96, 0x0F, 0xA0, 0x9B, 0x95, 0xD4, 0x9B, 0xD2, 0x96, 0x41, 0x9A, 0x9A, 0x99, 0x41, 0xA0, 0xD7,
+    0x9E, 0xF4, 0x98, 0x11, 0x9D, 0xAC, 0x96, 0x86, 0x95, 0xCD, 0xA0, 0x05, 0x9C, 0x28, 0xA0, 0x4F,
+    0x97, 0x4E, 0x9C, 0x2E, 0x97, 0xFD, 0xA1, 0x2A, 0x9D, 0xD4, 0x9D, 0x40, 0x96, 0x66, 0x97, 0x02,
+    0xA0, 0x99, 0x93, 0x9A, 0x95, 0x79, 0x9C, 0xE9, 0x9C, 0x58, 0x94, 0xC4, 0x93, 0x7E, 0x95, 0x38,
+    0x95, 0xCD, 0x98, 0x15, 0x93, 0xD0, 0x9B, 0x1A, 0x9A, 0x9E, 0x9A, 0x70, 0x97, 0x55, 0x97, 0x79,
+    0x9C, 0xA2, 0x95, 0x17, 0x9D, 0x4B, 0x97, 0xEC, 0x97, 0x58, 0x9A, 0xC5, 0x9D, 0x55, 0x97, 0xB5,
+    0x9C, 0x81, 0x9B, 0xC3, 0x95, 0x7B, 0x9A, 0xE3,
+};
+
+static const uint8_t GoldenBottom[1032] = {
+    0x94, 0x70, 0x92, 0xE7, 0x94, 0xCF, 0x96, 0xBA, 0x9B, 0x57, 0x92, 0xD0, 0x99, 0x10, 0x9E, 0x64,
+    0x9B, 0xA0, 0x9D, 0xA1, 0x95, 0xF3, 0x9B, 0xDA, 0x9D, 0x34, 0x94, 0x79, 0x96, 0x6A, 0x9B, 0x38,
+    0x96, 0x7B, 0x99, 0x19, 0x9E, 0x49, 0x98, 0x86, 0x9C, 0x0E, 0x9B, 0x68, 0x98, 0x81, 0x93, 0x98,
+    0x9A, 0xB6, 0x9C, 0x46, 0x97, 0x8F, 0x95, 0xCD, 0x96, 0x35, 0x96, 0x8B, 0x9B, 0x9C, 0x9B, 0x12,
+    0x9C, 0x89, 0x9A, 0xB8, 0x97, 0xDD, 0x94, 0x7E, 0x98, 0xFE, 0x95, 0x2A, 0x97, 0xCA, 0x98, 0xFD,
+    0x96, 0x53, 0x9B, 0xDC, 0x9A, 0x99, 0x99, 0x0F, 0x99, 0x6A, 0x9F, 0x74, 0x9C, 0x12, 0xA0, 0x21,
+    0x98, 0x33, 0xA0, 0x23, 0xA0, 0x42, 0x9D, 0x71, 0x9B, 0xFF, 0x95, 0x57, 0x95, 0x13, 0x98, 0x63,
+    0x9A, 0x3F, 0x9E, 0x82, 0x97, 0x40, 0x98, 0x79, 0x96, 0x5D, 0x9E, 0x93, 0x9A, 0xB4, 0x9A, 0x15,
+    0x98, 0xAF, 0x99, 0x72, 0x99, 0x62, 0x9A, 0xF7, 0x9A, 0xB9, 0x9E, 0x46, 0x9E, 0x5C, 0x95, 0xCB,
+    0x99, 0x8A, 0x9A, 0xA1, 0x98, 0x46, 0xA0, 0x2A, 0x99, 0xEC, 0x98, 0x20, 0xA0, 0x5A, 0xA0, 0x56,
+    0x9A, 0xC6, 0x97, 0x3E, 0x99, 0x0C, 0x9D, 0x49, 0x98, 0xD4, 0xA0, 0x60, 0x9D, 0x2D, 0x99, 0xC5,
+    0x9B, 0x9C, 0x98, 0xC0, 0x94, 0x7E, 0x9C, 0x36, 0x93, 0x2C, 0x9A, 0x98, 0x97, 0x20, 0x95, 0x89,
+    0x93, 0xFD, 0x9D, 0x02, 0x99, 0x0B, 0x9A, 0xDA, 0x97, 0x3C, 0x98, 0x20, 0x9A, 0x89, 0x97, 0xA3,
+    0x9E, 0xC8, 0x98, 0xC3, 0x94, 0x47, 0x9E, 0x7E, 0x9B, 0x0D, 0x97, 0x9A, 0x9C, 0xED, 0x9E, 0xEE,
+    0x97, 0x12, 0x9E, 0xD6, 0x95, 0x61, 0x95, 0xD2, 0x99, 0xF0, 0x94, 0x06, 0x9A, 0x7A, 0x9D, 0xB8,
+    0x9F, 0x18, 0x9A, 0x83, 0x94, 0xE7, 0x9C, 0x36, 0x98, 0xA3, 0x9A, 0x23, 0x9A, 0x37, 0x9C, 0x90,
+    0x9D, 0x42, 0x94, 0x70, 0x9C, 0xDC, 0x98, 0x54, 0x99, 0xA2, 0x98, 0x32, 0x9C, 0x8B, 0x9F, 0x0F,
+    0x94, 0xC9, 0x9C, 0xEB, 0x9F, 0xF7, 0x9B, 0x28, 0x9E, 0x40, 0x96, 0x7B, 0x97, 0x76, 0x99, 0xF9,
+    0x96, 0xE3, 0x9F, 0x31, 0x98, 0x49, 0x99, 0xE6, 0x99, 0x9A, 0x9E, 0xA0, 0x98, 0xFE, 0x9A, 0xC7,
+    0x95, 0x90, 0x9C, 0xE8, 0x9B, 0x08, 0x9D, 0x7B, 0x9B, 0x1E, 0x9A, 0xB3, 0x9A, 0xF3, 0xA0, 0xFA,
+    0x9A, 0x80, 0x9D, 0xB7, 0x9F, 0x73, 0x97, 0x89, 0x9A, 0xA5, 0xA0, 0xA8, 0x96, 0x24, 0x96, 0xB0,
+    0xA0, 0x09, 0x9B, 0x9D, 0x9A, 0x11, 0x99, 0x95, 0x99, 0x1C, 0x98, 0x80, 0xA2, 0x17, 0x9F, 0x50,
+    0x97, 0xA2, 0x9A, 0xEC, 0x94, 0xBD, 0x9B, 0xFA, 0x98, 0xEF, 0x9D, 0x34, 0x97, 0x10, 0x9D, 0x75,
+    0x99, 0x5F, 0x99, 0xE4, 0x98, 0xBF, 0x94, 0x28, 0x9D, 0xDD, 0x95, 0xD5, 0x94, 0xF6, 0x95, 0x0D,
+    0x9E, 0x4E, 0x9A, 0x18, 0x98, 0xB8, 0x98, 0x41, 0x99, 0x91, 0x95, 0x6E, 0x99, 0x6B, 0x96, 0x15,
+    0x94, 0xB2, 0x98, 0x1E, 0x9E, 0x69, 0x9C, 0x35, 0x95, 0xC2, 0x95, 0x74, 0x9F, 0x2F, 0x96, 0x8B,
+    0x9A, 0x73, 0x9F, 0x17, 0x99, 0x9F, 0x9F, 0x5A, 0x97, 0xEE, 0x97, 0xB0, 0x9E, 0x98, 0x96, 0x25,
+    0x99, 0x8F, 0x9A, 0xE0, 0x95, 0xB3, 0x9B, 0x88, 0x9D, 0x16, 0x9F, 0x38, 0x9B, 0x6E, 0x9C, 0xC4,
+    0x9B, 0x4E, 0x9C, 0xD8, 0x9E, 0xA3, 0x9A, 0xF5, 0x9D, 0x87, 0x9C, 0xE3, 0x98, 0x68, 0x9B, 0xFE,
+    0x9E, 0xFD, 0x9C, 0x18, 0x95, 0x2E, 0x9D, 0x69, 0x9B, 0x91, 0x99, 0xD1, 0x95, 0xAC, 0xA0, 0xE9,
+    0x97, 0x7E, 0xA0, 0xED, 0x98, 0x7B, 0x9B, 0x22, 0x97, 0xFB, 0x9B, 0xC0, 0xA0, 0x5A, 0xA1, 0x06,
+    0x9C, 0x1D, 0x9C, 0x87, 0xA1, 0x69, 0x9C, 0x88, 0x9B, 0x44, 0x96, 0xCE, 0x99, 0xF0, 0x99, 0x0A,
+    0xA1, 0xA3, 0xA0, 0x2D, 0x94, 0x70, 0x98, 0x84, 0x98, 0x3D, 0x9D, 0xAF, 0x9C, 0xC1, 0x99, 0x2A,
+    0x96, 0xA6, 0x98, 0xC6, 0x97, 0x9D, 0x98, 0xBD, 0x99, 0x0D, 0x98, 0x56, 0x9C, 0x19, 0x95, 0x3B,
+    0x9C, 0xA8, 0x9E, 0x06, 0x9D, 0xEF, 0x93, 0x39, 0x96, 0xCA, 0x93, 0x66, 0x95, 0xE3, 0x99, 0xD5,
+    0x9A, 0x66, 0x99, 0xA9, 0x98, 0x12, 0x97, 0x41, 0x96, 0xB8, 0x9E, 0xB0, 0x98, 0x29, 0x99, 0xF4,
+    0x98, 0xE1, 0x9A, 0xD6, 0x97, 0x35, 0x98, 0x86, 0x9A, 0x4D, 0x95, 0x44, 0x98, 0x12, 0x97, 0x76,
+    0x9E, 0xAE, 0x9D, 0xBD, 0x9D, 0x0E, 0x99, 0x26, 0x9D, 0xF1, 0x9C, 0x29, 0x98, 0x3D, 0x9F, 0x23,
+    0x9E, 0x1E, 0x9B, 0x1C, 0x96, 0xAD, 0x97, 0xE0, 0x9C, 0xDA, 0x95, 0x16, 0x95, 0x32, 0x96, 0x7A,
+    0x9C, 0x3E, 0x9D, 0x3A, 0x95, 0x81, 0x95, 0xB3, 0x95, 0xC7, 0x95, 0xA2, 0x9C, 0x16, 0x9F, 0xE9,
+    0x9F, 0xF7, 0xA0, 0x8F, 0x9E, 0xE9, 0x9F, 0x1E, 0x96, 0x01, 0x96, 0x63, 0x99, 0x6A, 0x9B, 0x10,
+    0x99, 0xDE, 0x96, 0xB9, 0x95, 0xDB, 0x98, 0xF9, 0xA1, 0x4C, 0x99, 0xEA, 0xA1, 0x45, 0xA1, 0x5E,
+    0x9C, 0x6C, 0x9F, 0x78, 0x9F, 0x2F, 0x99, 0xE9, 0xA0, 0x11, 0x96, 0x74, 0x99, 0x14, 0x96, 0x81,
+    0x9D, 0x06, 0x9C, 0xBA, 0x9A, 0xAC, 0x9A, 0x5F, 0x98, 0x5F, 0x97, 0x79, 0x9D, 0xB8, 0x9C, 0xF0,
+    0x99, 0x3C, 0x9A, 0xE2, 0x9B, 0x6C, 0x9A, 0x24, 0x96, 0x30, 0x95, 0xAC, 0x9B, 0x6B, 0x9A, 0xF0,
+    0x95, 0x82, 0x97, 0xB7, 0x92, 0xF7, 0x94, 0x61, 0x9E, 0x83, 0x96, 0x5C, 0x9A, 0x44, 0x9B, 0xC6,
+    0x94, 0xDD, 0x94, 0xED, 0x97, 0x10, 0x9A, 0x38, 0x9D, 0xD4, 0x98, 0xE4, 0x9F, 0x07, 0x96, 0x65,
+    0x93, 0xF2, 0x96, 0x0B, 0x96, 0xB6, 0x95, 0x40, 0x9E, 0xDA, 0x94, 0xB2, 0x9C, 0x89, 0x9D, 0xF5,
+    0x9E, 0x66, 0x95, 0x4E, 0x9D, 0x60, 0x94, 0x70, 0x94, 0xDC, 0x9A, 0x87, 0x9A, 0x6B, 0x9F, 0xA7,
+    0x97, 0xA9, 0x98, 0x9D, 0x96, 0xFB, 0x96, 0xF8, 0x9B, 0x5B, 0xA0, 0x52, 0x99, 0xE4, 0x97, 0xF8,
+    0x95, 0x78, 0x97, 0xB6, 0x9F, 0x11, 0x9F, 0xC6, 0x9B, 0x80, 0x96, 0x4F, 0x95, 0xB1, 0x9A, 0x9D,
+    0x98, 0x14, 0x98, 0xB5, 0x9A, 0x09, 0x9C, 0xE4, 0x9D, 0x1B, 0x9F, 0xAC, 0x9A, 0xA9, 0xA1, 0x17,
+    0x97, 0x9C, 0x9F, 0xB7, 0x9E, 0x54, 0x97, 0xE3, 0x95, 0xB9, 0x99, 0x69, 0x9E, 0x0B, 0x9B, 0xA3,
+    0x9D, 0x30, 0x99, 0xAC, 0x97, 0xF9, 0x9D, 0xD0, 0x99, 0x8B, 0x9F, 0x1D, 0x9E, 0x2E, 0xA1, 0x3A,
+    0x98, 0xD7, 0x9F, 0x44, 0x98, 0xFE, 0xA1, 0xA3, 0x9D, 0x77, 0x9D, 0x26, 0x96, 0xF8, 0x9A, 0x23,
+    0x92, 0xAC, 0x9D, 0x28, 0x93, 0xB6, 0x96, 0xFE, 0x9A, 0xC0, 0x9C, 0x1F, 0x94, 0x7E, 0x93, 0x7F,
+    0x9D, 0x2D, 0x96, 0x78, 0x97, 0xD8, 0x9D, 0x39, 0x9C, 0x64, 0x94, 0x70, 0x9A, 0x6D, 0x99, 0x27,
+    0x96, 0x95, 0x94, 0x17, 0x9A, 0xF8, 0x99, 0x07, 0x98, 0xC1, 0x9A, 0x03, 0x96, 0x19, 0x98, 0x65,
+    0x95, 0xAC, 0x9A, 0x8C, 0x97, 0x0D, 0x99, 0x3F, 0x95, 0x63, 0x99, 0x60, 0x97, 0xF2, 0x94, 0xE9,
+    0x9E, 0xA1, 0x98, 0x8F, 0x96, 0xA4, 0x97, 0x60, 0x9A, 0x22, 0x9A, 0xE5, 0x9A, 0x5C, 0x9A, 0xF0,
+    0x98, 0x7B, 0x96, 0xFD, 0x96, 0x86, 0x94, 0xB0, 0x9B, 0xAD, 0x95, 0xFA, 0x94, 0xE1, 0x99, 0x9B,
+    0x9D, 0x80, 0x95, 0xF6, 0x9D, 0x51, 0x9D, 0xFF, 0x9A, 0x6C, 0x98, 0xED, 0x9C, 0xD7, 0x9F, 0x90,
+    0x96, 0x88, 0x9F, 0x19, 0x9D, 0x1D, 0x95, 0xE4, 0x9C, 0x65, 0x96, 0xB6, 0x9A, 0xCC, 0x9D, 0x06,
+    0xA1, 0x01, 0x99, 0x8D, 0x9D, 0x18, 0x9C, 0x85, 0xA0, 0xDE, 0xA0, 0xD3, 0x9E, 0x91, 0x97, 0x5C,
+    0xA0, 0x5B, 0x96, 0x01, 0x9E, 0xCA, 0x98, 0x02,
+};
+
+static const uint8_t GoldenElOffsetTop[258] = {
+    0x94, 0x70, 0x82, 0x63, 0x89, 0xE7, 0x84, 0xC1, 0x80, 0xC8, 0x86, 0xBA, 0x86, 0x02, 0x83, 0x19,
+    0x86, 0x16, 0x8A, 0x4F, 0x83, 0x6E, 0x87, 0x1B, 0x84, 0x8C, 0x84, 0x3C, 0x85, 0xF4, 0x80, 0xE7,
+    0x7F, 0x21, 0x7F, 0xB7, 0x85, 0xD0, 0x89, 0xF0, 0x88, 0x76, 0x80, 0x91, 0x7F, 0x22, 0x88, 0x4D,
+    0x82, 0x82, 0x82, 0xF0, 0x86, 0xE7, 0x86, 0x71, 0x83, 0x77, 0x87, 0x04, 0x86, 0x06, 0x83, 0x04,
+    0x83, 0xDC, 0x84, 0xA3, 0x83, 0x0D, 0x81, 0x0A, 0x83, 0x03, 0x85, 0xCF, 0x85, 0x6C, 0x7F, 0xC9,
+    0x87, 0x9B, 0x80, 0xA5, 0x82, 0xB7, 0x83, 0x4E, 0x86, 0x5D, 0x87, 0x1E, 0x88, 0xA6, 0x84, 0xA7,
+    0x89, 0x00, 0x89, 0x07, 0x80, 0x7E, 0x82, 0xEF, 0x84, 0x2F, 0x83, 0x5B, 0x82, 0xEF, 0x86, 0x1F,
+    0x82, 0x88, 0x80, 0xDE, 0x84, 0x7E, 0x88, 0xC2, 0x8A, 0x5D, 0x87, 0x3A, 0x80, 0x63, 0x89, 0xB6,
+    0x82, 0xD5, 0x86, 0xE4, 0x83, 0x22, 0x80, 0x40, 0x8A, 0xD2, 0x88, 0xAD, 0x7F, 0x5C, 0x89, 0x46,
+    0x8A, 0xAA, 0x7F, 0x8B, 0x7F, 0x9D, 0x81, 0xB5, 0x83, 0x68, 0x87, 0xA0, 0x80, 0x16, 0x82, 0x93,
+    0x82, 0x52, 0x85, 0x18, 0x8A, 0x62, 0x8A, 0x54, 0x8A, 0xC3, 0x7F, 0xAD, 0x82, 0x2B, 0x86, 0xD7,
+    0x86, 0x81, 0x87, 0x4D, 0x87, 0xAC, 0x83, 0xAF, 0x7F, 0x66, 0x82, 0x90, 0x83, 0xE7, 0x84, 0xDD,
+    0x86, 0x40, 0x89, 0x05, 0x83, 0x7E, 0x84, 0xD3, 0x89, 0xBB, 0x89, 0x7C, 0x83, 0x63, 0x84, 0xC8,
+    0x88, 0x94, 0x89, 0xD3, 0x86, 0xAB, 0x84, 0x11, 0x86, 0xAE, 0x87, 0x53, 0x81, 0x7D, 0x7F, 0xB4,
+    0x7F, 0xAF, 0x83, 0x92, 0x83, 0x2E, 0x7F, 0xD5, 0x86, 0x11, 0x85, 0xC1, 0x84, 0xBE, 0x81, 0x43,
+    0x80, 0x14, 0x83, 0xDD, 0x85, 0xF9, 0x83, 0x51, 0x89, 0x11, 0x82, 0x48, 0x83, 0x11, 0x83, 0xD8,
+    0x7F, 0xFE,
+};
+
+static const uint8_t GoldenElOffsetBottom[258] = {
+    0x94, 0x70, 0x89, 0x68, 0x80, 0x21, 0x89, 0x15, 0x83, 0x91, 0x85, 0x78, 0x86, 0xBD, 0x87, 0xAE,
+    0x8A, 0x35, 0x83, 0x21, 0x85, 0x0C, 0x83, 0x94, 0x81, 0x3D, 0x80, 0xD8, 0x8A, 0x4E, 0x82, 0x99,
+    0x87, 0xDF, 0x84, 0x00, 0x83, 0xA1, 0x8A, 0xB7, 0x82, 0x46, 0x89, 0x96, 0x80, 0xB4, 0x80, 0xC0,
+    0x88, 0xC1, 0x84, 0x8C, 0x89, 0xEE, 0x82, 0xD5, 0x88, 0xCB, 0x89, 0x70, 0x86, 0xE6, 0x88, 0x69,
+    0x80, 0x6B, 0x80, 0xAC, 0x81, 0x2B, 0x88, 0xE4, 0x8A, 0x0C, 0x8A, 0x7E, 0x89, 0x6B, 0x85, 0xA3,
+    0x89, 0xEC, 0x88, 0x28, 0x85, 0x6E, 0x88, 0x5D, 0x82, 0x77, 0x84, 0x07, 0x81, 0x02, 0x86, 0x05,
+    0x8A, 0x53, 0x8A, 0x85, 0x89, 0x06, 0x81, 0xB5, 0x87, 0xEB, 0x83, 0x49, 0x84, 0xE2, 0x89, 0x27,
+    0x81, 0x26, 0x83, 0x74, 0x7F, 0xFC, 0x89, 0xBC, 0x80, 0x07, 0x87, 0xAC, 0x81, 0xE2, 0x87, 0x18,
+    0x81, 0x65, 0x81, 0x63, 0x8B, 0x8C, 0x88, 0xE9, 0x82, 0xA3, 0x86, 0x8E, 0x8A, 0x19, 0x84, 0x7D,
+    0x89, 0x2F, 0x88, 0xD0, 0x8B, 0x87, 0x82, 0xD3, 0x8B, 0xA5, 0x8A, 0x27, 0x80, 0x4E, 0x88, 0xDF,
+    0x88, 0x4B, 0x86, 0x1C, 0x84, 0x64, 0x80, 0xC1, 0x84, 0x34, 0x80, 0x2E, 0x83, 0x80, 0x81, 0x1D,
+    0x81, 0xBF, 0x82, 0xFD, 0x82, 0xA1, 0x89, 0xC2, 0x85, 0xA7, 0x85, 0xC9, 0x86, 0x86, 0x86, 0xE4,
+    0x8A, 0x43, 0x88, 0x03, 0x89, 0xDD, 0x87, 0xEC, 0x8B, 0x5D, 0x8A, 0xF8, 0x80, 0xFF, 0x83, 0x25,
+    0x89, 0x4E, 0x88, 0x1B, 0x87, 0x90, 0x85, 0xD0, 0x89, 0x76, 0x89, 0xB9, 0x87, 0xDA, 0x81, 0x3F,
+    0x86, 0xE6, 0x89, 0x5D, 0x84, 0xD1, 0x89, 0xCB, 0x80, 0xE0, 0x89, 0x04, 0x89, 0x16, 0x85, 0xC0,
+    0x81, 0x7B, 0x81, 0x39, 0x83, 0x6E, 0x86, 0xE5, 0x8B, 0x52, 0x81, 0x10, 0x85, 0xA2, 0x88, 0x4F,
+    0x8A, 0x0C,
+};
+
+static const uint16_t GoldenPTAT[8] = {
+    38000, 38000, 38000, 38000, 38000, 38000, 38000, 38000,
+};
+
+static const uint16_t GoldenVDD[8] = {
+    31000, 31000, 31000, 31000, 31000, 31000, 31000, 31000,
+};
+
+static const int16_t GoldenTemps[1024] = {
+     4258,  4525,  3931,  4628,  3967,  4198,  4086,  4528,  4071,  4409,  4151,  4377,  4458,  4351,  4782,  4628,
+     4308,  4021,  3971,  4437,  4580,  4917,  4151,  4195,  4351,  4217,  4264,  5160,  4286,  4344,  4457,  4608,
+     4503,  4387,  4949,  4380,  4764,  4217,  4762,  3894,  4406,  4312,  4668,  4199,  4039,  4145,  4815,  4246,
+     4162,  4540,  4672,  4463,  4578,  4349,  3960,  4247,  4769,  4160,  4390,  4017,  4473,  4987,  4262,  4341,
+     4055,  5149,  4501,  4145,  4571,  4288,  4149,  4283,  4949,  4548,  4271,  4802,  4071,  4565,  4189,  4223,
+     4626,  4221,  3890,  4157,  5152,  4523,  4268,  4469,  4131,  4487,  5033,  5000,  4390,  4160,  4431,  4891,
+     4393,  4045,  4431,  4005,  4012,  4604,  4361,  4097,  4027,  4145,  4495,  4561,  3937,  4703,  4554,  4867,
+     4104,  4250,  4814,  4545,  4599,  4455,  4344,  4769,  4012,  3999,  3982,  3819,  4987,  4841,  4577,  4767,
+     4908,  4482,  4167,  4537,  4563,  4287,  4811,  4876,  4122,  4476,  3973,  4340,  4021,  4534,  4983,  4585,
+     4462,  4234,  4318,  4598,  4764,  4581,  4602,  4290,  4545,  4657,  4336,  4419,  4644,  4944,  4580,  4560,
+     4152,  4448,  4513,  4190,  4804,  4554,  4428,  4358,  4667,  4633,  4044,  4072,  4566,  4213,  4159,  4555,
+     4754,  4697,  4240,  4397,  5157,  4983,  4907,  4582,  4723,  4043,  4038,  3822,  4447,  4453,  4634,  4543,
+     4693,  4352,  4648,  3762,  3992,  4589,  3911,  4359,  4636,  4411,  4005,  4506,  3922,  4212,  4280,  4210,
+     4164,  4312,  3854,  3657,  4755,  4383,  4388,  4230,  4418,  3787,  4177,  4688,  4336,  4428,  4655,  4020,
+     4342,  4081,  4840,  4154,  3773,  4219,  4375,  4102,  4029,  4189,  4013,  4035,  4299,  4743,  4277,  5391,
+     4610,  4722,  4587,  4378,  4278,  4481,  4149,  4496,  4683,  4080,  4566,  4014,  4405,  4451,  4534,  4578,
+     4495,  3967,  4637,  4566,  4572,  4521,  4293,  4538,  4257,  4549,  4525,  4042,  4543,  4629,  4609,  5337,
+     4659,  4509,  4017,  4293,  4658,  4533,  4301,  4931,  4354,  4629,  4235,  4604,  4450,  4574,  4615,  4814,
+     4619,  5001,  4598,  4369,  4098,  4767,  4922,  3922,  4404,  4566,  4604,  4062,  4547,  4243,  4442,  4195,
+     3884,  4844,  4190,  4089,  4343,  4370,  4562,  4545,  4609,  4206,  4010,  4000,  4408,  4546,  4093,  4212,
+     4814,  5000,  4708,  3634,  4038,  5304,  4111,  4115,  4902,  4481,  4837,  4742,  3997,  5152,  4299,  4478,
+     4461,  4355,  4276,  4087,  4376,  4265,  4310,  4290,  4396,  4337,  4754,  4199,  4690,  4461,  4734,  4039,
+     4339,  4559,  4274,  4373,  3924,  4971,  4153,  4327,  4256,  4873,  4203,  4010,  3979,  4560,  4416,  4506,
+     4623,  4591,  4317,  4327,  4268,  4962,  5046,  4423,  4587,  5037,  4356,  4141,  4630,  4333,  4630,  4553,
+     4425,  4575,  4484,  4455,  4606,  4543,  4468,  3944,  4056,  4105,  4397,  4528,  5043,  3930,  4392,  4777,
+     4398,  4528,  4240,  4489,  4368,  4659,  3862,  4463,  4581,  4095,  4297,  4985,  4285,  3870,  4473,  4861,
+     4330,  4312,  4666,  4246,  4329,  4331,  4607,  4289,  4969,  4429,  4660,  4362,  4278,  4151,  4352,  4183,
+     4608,  4247,  4263,  4379,  4454,  4898,  4254,  4286,  4647,  4030,  4450,  3764,  4545,  4687,  4108,  4181,
+     4695,  4297,  4713,  4008,  4427,  5119,  4528,  4428,  4723,  5041,  4468,  4521,  4024,  4574,  4510,  4771,
+     4172,  4413,  4006,  4217,  4983,  4502,  4362,  4456,  3957,  4663,  4337,  4824,  4150,  4369,  4568,  4660,
+     4371,  4367,  4139,  4088,  4556,  4346,  4194,  4097,  4192,  3859,  4090,  4152,  3971,  4248,  4662,  4980,
+     4315,  4511,  4665,  4277,  4750,  4475,  5084,  4376,  4411,  4171,  4578,  3885,  4789,  4482,  4151,  4495,
+     4619,  4169,  3859,  4090,  4426,  4206,  4856,  4121,  4402,  4315,  4881,  4581,  3904,  4334,  4702,  4406,
+     4398,  4237,  4331,  4852,  4400,  4014,  4293,  4588,  4654,  4592,  4367,  3961,  5018,  4272,  4798,  4335,
+     4371,  3752,  4251,  4656,  3962,  3920,  4747,  4445,  4287,  4158,  4410,  4271,  3801,  4815,  4135,  4115,
+     3918,  4730,  4373,  4178,  4729,  4231,  4589,  4702,  4785,  4537,  3965,  4144,  4225,  4175,  3966,  3644,
+     4121,  4598,  4239,  4516,  4398,  4109,  4325,  4484,  4062,  4404,  4225,  4755,  4659,  4605,  4038,  4586,
+     4168,  4311,  4776,  4247,  4457,  4646,  4060,  4221,  4309,  4435,  3754,  4058,  4606,  4135,  4268,  4641,
+     3671,  4819,  4224,  4432,  4211,  4499,  4134,  3936,  4285,  4920,  4457,  4442,  4331,  3952,  5064,  4691,
+     4582,  4189,  4054,  4813,  4073,  4504,  4316,  4438,  4451,  4214,  4343,  4326,  4305,  4392,  4539,  4951,
+     4323,  4238,  4180,  4434,  4249,  4249,  4271,  3682,  4154,  4309,  4174,  4064,  4569,  3924,  4449,  4041,
+     4100,  4328,  4033,  4576,  3848,  4160,  4219,  4185,  4283,  5043,  4064,  4445,  4790,  4733,  4184,  4061,
+     5225,  3809,  3900,  4490,  4177,  4059,  4060,  3869,  4368,  4280,  4315,  4188,  4378,  5105,  4682,  4714,
+     4139,  4478,  4265,  4582,  4621,  4630,  4990,  4801,  4335,  4816,  4131,  4821,  4532,  4133,  4114,  4517,
+     4879,  4438,  3879,  4097,  4130,  4193,  4808,  4429,  4152,  4633,  4184,  4514,  4527,  4441,  4248,  3897,
+     3816,  4195,  4418,  3873,  4148,  4560,  4288,  4595,  4038,  4760,  4147,  4850,  4563,  4504,  4921,  4850,
+     4322,  4414,  4234,  4568,  4626,  4395,  4021,  3885,  4275,  4416,  4362,  5074,  4351,  4476,  4939,  4239,
+     3854,  4180,  3708,  4471,  4059,  4565,  4904,  4313,  4133,  3940,  4592,  4428,  4263,  4575,  4454,  4250,
+     4491,  4182,  4699,  4391,  3870,  4573,  4430,  4576,  4219,  4253,  4542,  4218,  3779,  4419,  4674,  4563,
+     4065,  4797,  3879,  5117,  4344,  4973,  4391,  4709,  4562,  4546,  4399,  3780,  4398,  4098,  4952,  4826,
+     4699,  4313,  4246,  4362,  4207,  3685,  4512,  4087,  4783,  4443,  4263,  4093,  4295,  4373,  4346,  4280,
+     4245,  4884,  4706,  4097,  4902,  4212,  4921,  4443,  4561,  4880,  4373,  4546,  4356,  4440,  4660,  4224,
+     4758,  4311,  4148,  4731,  4185,  3898,  4500,  4266,  4108,  4125,  4186,  4385,  4599,  5151,  4512,  4036,
+     3796,  4361,  4571,  4147,  4257,  4363,  3952,  4379,  4257,  4775,  4450,  4143,  4141,  4277,  4448,  4650,
+     4193,  4589,  4023,  4557,  4474,  4915,  4131,  4225,  4903,  4386,  4627,  4400,  4625,  4087,  4273,  4811,
+     4317,  4332,  4118,  4969,  4138,  4611,  4131,  4166,  4463,  4675,  4796,  4312,  4066,  5075,  4279,  4756,
+     4433,  4306,  4129,  3699,  3767,  4615,  4133,  4760,  3994,  3954,  4767,  4307,  4082,  4426,  5296,  4358,
+     4303,  4479,  3786,  4432,  3904,  4372,  4254,  5079,  4580,  4135,  4283,  3804,  4394,  4601,  4197,  4456,
+     4328,  3997,  4035,  4268,  4648,  4574,  4176,  4531,  4324,  3965,  4511,  3885,  3859,  5158,  4284,  4352,
+     4186,  4342,  4425,  4569,  5118,  4842,  4601,  4645,  4708,  4328,  4450,  4314,  4138,  4351,  3871,  3869,
+     4550,  4530,  4119,  4069,  3690,  4318,  4151,  3825,  4172,  4260,  4251,  4568,  4699,  4672,  5004,  4005,
+     4449,  4470,  4453,  4156,  4547,  4280,  3993,  4701,  4622,  4593,  4170,  4263,  4868,  4527,  4272,  4445,
+     3631,  4809,  3937,  4674,  3963,  4086,  4467,  4386,  4368,  3941,  4301,  4809,  4231,  4155,  4426,  4209,
+     4195,  4442,  4206,  4527,  4365,  4263,  4099,  4604,  4236,  3845,  4247,  3854,  4234,  4429,  4114,  4415,
+};
+
+#endif
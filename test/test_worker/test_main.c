@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "render.h"
+#include "palette.h"
+
+// Render worker on a real thread: frames rendered band by band, with the
+// bottom rows of each band on the worker like DrawImage, against the same
+// frames rendered on one thread, for every engine and several shares.
+
+#define WIDTH       264
+#define HEIGHT      224
+#define BAND        28
+#define FRAMES      20
+
+typedef struct {
+    Render_Scaler_t *scaler;
+    int16_t *line;
+    Render_Target_t *band;
+    uint16_t top;
+    const Render_Map_t *map;
+    pthread_t thread;       // last thread running the job
+    uint32_t rows;
+} BandJob_t;
+
+static int16_t frame[HTPA_ROWS][HTPA_COLS];
+static Render_Layout_t layout;
+static Render_Scaler_t scaler[2];
+static int16_t line[2][RENDER_MAX_WIDTH];
+static Render_Map_t map;
+static Render_Worker_t worker, none;      // none has no task, jobs run inline
+static uint16_t single[HEIGHT][WIDTH], split[HEIGHT][WIDTH];
+static uint32_t rng;
+
+void setUp(void) {
+    rng = 11;
+}
+
+void tearDown(void) {}
+
+static void RandomFrame(int16_t base, uint16_t span) {
+    for (int i = 0; i < HTPA_ROWS; i++) {
+        for (int j = 0; j < HTPA_COLS; j++) {
+            rng = rng * 1103515245 + 12345;
+            frame[i][j] = base + (int16_t)((rng >> 16) % span);
+        }
+    }
+}
+
+// As RenderBandRows in main.cpp
+static void RenderBandRows(void *arg, uint16_t first, uint16_t count) {
+    BandJob_t *job = (BandJob_t *)arg;
+
+    job->thread = pthread_self();
+    job->rows += count;
+    for (uint16_t y = first; y < first + count; y++) {
+        Render_ScalerRow(job->scaler, job->top + y, 0, job->band->width, job->line);
+        Render_Colorize(job->line, Render_TargetRow(job->band, y), job->band->width, job->map);
+    }
+}
+
+// Renders the frame into image, share percent of each band on the worker
+static void RenderFrame(Render_Worker_t *w, uint16_t image[HEIGHT][WIDTH], int share, BandJob_t job[2]) {
+    for (int n = 0; n < 2; n++) {
+        job[n].scaler = &scaler[n];
+        job[n].line = line[n];
+        job[n].map = &map;
+        Render_ScalerBegin(&scaler[n], &layout, frame);
+    }
+    for (uint16_t top = 0; top < HEIGHT; top += BAND) {
+        Render_Target_t band = { &image[top][0], WIDTH, BAND, WIDTH };
+        int rows = BAND, first = rows - rows * share / 100;
+        for (int n = 0; n < 2; n++) {
+            job[n].band = &band;
+            job[n].top = top;
+        }
+        Render_WorkerRun(w, RenderBandRows, &job[1], first, rows - first);
+        RenderBandRows(&job[0], 0, first);
+        Render_WorkerJoin(w);
+    }
+}
+
+// The worker thread renders its share of every band, and the image is the
+// one a single thread renders, byte for byte
+static void test_split_frame_is_identical(void) {
+    static const int shares[] = { 0, 25, 50, 75, 100 };
+    BandJob_t job[2];
+    char msg[64];
+
+    TEST_ASSERT_EQUAL(HTPA_OK, Render_WorkerStart(&worker, "Render_Worker", 1, 0));
+    TEST_ASSERT_NOT_NULL(worker.task);
+    Render_MapInit(&map, getPaletteTable(PALETTE_IRON, true), PALETTE_SIZE, 2900, 3100);
+
+    for (uint8_t engine = 0; engine < RENDER_ENGINE_COUNT; engine++) {
+        TEST_ASSERT_EQUAL(HTPA_OK, Render_LayoutInit(&layout, engine, WIDTH, HEIGHT, true));
+        for (int n = 0; n < FRAMES; n++) {
+            RandomFrame(2880, 240);
+            for (size_t s = 0; s < sizeof(shares) / sizeof(shares[0]); s++) {
+                RenderFrame(&none, single, 0, job);
+                memset(split, 0, sizeof(split));
+                memset(job, 0, sizeof(job));
+                RenderFrame(&worker, split, shares[s], job);
+                snprintf(msg, sizeof(msg), "%s, frame %d, %d%% on the worker", Render_Engines[engine].name, n, shares[s]);
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(single, split, sizeof(single), msg);
+                TEST_ASSERT_EQUAL_UINT32_MESSAGE(HEIGHT / BAND * (BAND * shares[s] / 100), job[1].rows, msg);
+                if (job[1].rows) TEST_ASSERT_FALSE_MESSAGE(pthread_equal(job[1].thread, pthread_self()), msg);
+            }
+        }
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_split_frame_is_identical);
+    return UNITY_END();
+}